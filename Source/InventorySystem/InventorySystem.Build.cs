@@ -27,7 +27,8 @@ public class InventorySystem : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
-				"InputCore"
+				"InputCore",
+				"NetCore"
 			]
 		);
 
@@ -0,0 +1,157 @@
+#include "CraftingRequirementEvaluator.h"
+#include "InventoryComponent.h"
+
+void UCraftingRequirementEvaluator::SetRecipes(const TArray<FCraftingRecipe>& InRecipes)
+{
+	Recipes = InRecipes;
+
+	IngredientKeys.Reset();
+	CompiledIngredients.Reset();
+	RecipeIngredientStart.Reset(Recipes.Num() + 1);
+	RecipesByKey.Reset();
+	RecipeIndexByID.Reset();
+
+	TMap<uint64, int32> KeyIndexByKey;
+	for (int32 RecipeIndex = 0; RecipeIndex < Recipes.Num(); ++RecipeIndex)
+	{
+		const FCraftingRecipe& Recipe = Recipes[RecipeIndex];
+		RecipeIndexByID.Add(Recipe.RecipeID, RecipeIndex);
+
+		const int32 Start = CompiledIngredients.Num();
+		RecipeIngredientStart.Add(Start);
+
+		for (const FCraftingIngredient& Ingredient : Recipe.Ingredients)
+		{
+			if (Ingredient.Quantity <= 0)
+			{
+				continue;
+			}
+
+			const uint64 Key = FItemDefinition::MakeItemKey(Ingredient.ItemID);
+			int32* KeyIndexPtr = KeyIndexByKey.Find(Key);
+			if (!KeyIndexPtr)
+			{
+				KeyIndexPtr = &KeyIndexByKey.Add(Key, IngredientKeys.Add(Key));
+				RecipesByKey.AddDefaulted();
+			}
+
+			const int32 KeyIndex = *KeyIndexPtr;
+			FCompiledIngredient* Existing = nullptr;
+			for (int32 i = Start; i < CompiledIngredients.Num(); ++i)
+			{
+				if (CompiledIngredients[i].KeyIndex == KeyIndex)
+				{
+					Existing = &CompiledIngredients[i];
+					break;
+				}
+			}
+
+			if (Existing)
+			{
+				Existing->Quantity += Ingredient.Quantity;
+			}
+			else
+			{
+				CompiledIngredients.Add({KeyIndex, Ingredient.Quantity});
+				RecipesByKey[KeyIndex].Add(RecipeIndex);
+			}
+		}
+	}
+	RecipeIngredientStart.Add(CompiledIngredients.Num());
+
+	IngredientTotals.Init(0, IngredientKeys.Num());
+	CraftableCounts.Init(0, Recipes.Num());
+	ChangedRecipes.Reset();
+	bNeedsFullEvaluation = true;
+}
+
+void UCraftingRequirementEvaluator::SetInventory(UInventoryComponent* InInventory)
+{
+	Inventory = InInventory;
+	bNeedsFullEvaluation = true;
+}
+
+int32 UCraftingRequirementEvaluator::Refresh()
+{
+	ChangedRecipes.Reset();
+	LastEvaluatedCount = 0;
+
+	const UInventoryComponent* InventoryPtr = Inventory.Get();
+	if (!InventoryPtr)
+	{
+		for (int32 RecipeIndex = 0; RecipeIndex < CraftableCounts.Num(); ++RecipeIndex)
+		{
+			if (CraftableCounts[RecipeIndex] != 0)
+			{
+				CraftableCounts[RecipeIndex] = 0;
+				ChangedRecipes.Add(RecipeIndex);
+			}
+		}
+		IngredientTotals.Init(0, IngredientKeys.Num());
+		bNeedsFullEvaluation = true;
+		return ChangedRecipes.Num();
+	}
+
+	const FInventorySlotsGroup& Groups = InventoryPtr->GetInventorySlotsGroup();
+	const uint64 ContentVersion = Groups.GetContentVersion();
+	if (!bNeedsFullEvaluation && ContentVersion == EvaluatedContentVersion)
+	{
+		return 0;
+	}
+
+	TBitArray<> DirtyRecipes(bNeedsFullEvaluation, Recipes.Num());
+	for (int32 KeyIndex = 0; KeyIndex < IngredientKeys.Num(); ++KeyIndex)
+	{
+		const int32 Total = Groups.GetGlobalTotalItemCount(IngredientKeys[KeyIndex]);
+		if (Total != IngredientTotals[KeyIndex])
+		{
+			IngredientTotals[KeyIndex] = Total;
+			for (int32 RecipeIndex : RecipesByKey[KeyIndex])
+			{
+				DirtyRecipes[RecipeIndex] = true;
+			}
+		}
+	}
+
+	for (TConstSetBitIterator<> It(DirtyRecipes); It; ++It)
+	{
+		const int32 RecipeIndex = It.GetIndex();
+		const int32 Count = EvaluateRecipe(RecipeIndex);
+		++LastEvaluatedCount;
+
+		if (Count != CraftableCounts[RecipeIndex])
+		{
+			CraftableCounts[RecipeIndex] = Count;
+			ChangedRecipes.Add(RecipeIndex);
+		}
+	}
+
+	EvaluatedContentVersion = ContentVersion;
+	bNeedsFullEvaluation = false;
+	return ChangedRecipes.Num();
+}
+
+int32 UCraftingRequirementEvaluator::GetCraftableCount(FName RecipeID) const
+{
+	const int32* RecipeIndex = RecipeIndexByID.Find(RecipeID);
+	return RecipeIndex ? CraftableCounts[*RecipeIndex] : 0;
+}
+
+int32 UCraftingRequirementEvaluator::EvaluateRecipe(int32 RecipeIndex) const
+{
+	const int32 Start = RecipeIngredientStart[RecipeIndex];
+	const int32 End = RecipeIngredientStart[RecipeIndex + 1];
+	if (Start == End)
+	{
+		return 0;
+	}
+
+	int32 Craftable = MAX_int32;
+	for (int32 i = Start; i < End && Craftable > 0; ++i)
+	{
+		const FCompiledIngredient& Ingredient = CompiledIngredients[i];
+		Craftable = FMath::Min(Craftable, IngredientTotals[Ingredient.KeyIndex] / Ingredient.Quantity);
+	}
+
+	return Craftable;
+}
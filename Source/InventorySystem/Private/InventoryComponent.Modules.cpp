@@ -2,6 +2,7 @@
 #include "InventorySystem.h"
 #include "InventoryDebugSubsystem.h"
 #include "Modules/InventoryModuleBase.h"
+#include "Net/Core/PushModel/PushModel.h"
 /**
  * Attaches a pre-instantiated module to the inventory system.
  * @param Module The module instance to install.
@@ -30,6 +31,9 @@ FInventoryOperationResult UInventoryComponent::InstallModule(UInventoryModuleBas
 	}
 
 	InstalledModules.Add(Module);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InstalledModules, this);
+	++NetMetrics.PropertiesMarkedDirty;
+	AddReplicatedSubObject(Module);
 	Module->InitializeModule();
 
 	if (HasBegunPlay())
@@ -111,6 +115,9 @@ FInventoryOperationResult UInventoryComponent::RemoveModule(UInventoryModuleBase
 
 	if (InstalledModules.Remove(Module) > 0)
 	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InstalledModules, this);
+		++NetMetrics.PropertiesMarkedDirty;
+		RemoveReplicatedSubObject(Module);
 		Module->OnModuleRemoved();
 
 		// Disable tick if no remaining module needs it
@@ -0,0 +1,403 @@
+#include "InventoryComponent.h"
+#include "InventorySystem.h"
+#include "InventoryDebugSubsystem.h"
+#include "InventoryOnDemandSlots.h"
+#include "Net/NetworkSubsystem.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+FName UInventoryComponent::GetSessionNetGroup() const
+{
+	if (SessionNetGroup.IsNone())
+	{
+		// The number suffix keeps every inventory's group under one name table entry
+		SessionNetGroup = FName(TEXT("InventorySession"), static_cast<int32>(GetUniqueID()));
+	}
+	return SessionNetGroup;
+}
+
+APlayerController* UInventoryComponent::GetOwningController() const
+{
+	// A possessed pawn is owned by its controller, and items or equipment by the pawn
+	for (AActor* Actor = GetOwner(); Actor; Actor = Actor->GetOwner())
+	{
+		if (APlayerController* PC = Cast<APlayerController>(Actor))
+		{
+			return PC;
+		}
+	}
+	return nullptr;
+}
+
+bool UInventoryComponent::IsInSessionRange(const APlayerController* Viewer) const
+{
+	if (MaxSessionDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	const AActor* Owner = GetOwner();
+	const APawn* ViewerPawn = Viewer ? Viewer->GetPawn() : nullptr;
+	if (!Owner || !ViewerPawn)
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(Owner->GetActorLocation(), ViewerPawn->GetActorLocation()) <= FMath::Square(MaxSessionDistance);
+}
+
+bool UInventoryComponent::CanOpenSession_Implementation(APlayerController* Viewer) const
+{
+	return true;
+}
+
+FInventoryOperationResult UInventoryComponent::AddSession(APlayerController* Viewer, UInventoryComponent* ViewerInventory)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("AddSession: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_OpenContainer, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	if (!IsValid(Viewer))
+	{
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Invalid viewer"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_OpenContainer, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("Invalid viewer"));
+		return FailResult;
+	}
+
+	if (!IsInSessionRange(Viewer))
+	{
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Viewer is out of range"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_OpenContainer, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), Viewer->GetName());
+		return FailResult;
+	}
+
+	if (!CanOpenSession(Viewer))
+	{
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Viewer may not open this inventory"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_OpenContainer, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), Viewer->GetName());
+		return FailResult;
+	}
+
+	FContainerSession* Existing = Sessions.FindByPredicate([Viewer](const FContainerSession& Session)
+	{
+		return Session.Viewer.Get() == Viewer;
+	});
+
+	if (Existing)
+	{
+		Existing->ViewerInventory = ViewerInventory;
+	}
+	else
+	{
+		FContainerSession& Session = Sessions.AddDefaulted_GetRef();
+		Session.Viewer = Viewer;
+		Session.ViewerInventory = ViewerInventory;
+		Viewer->IncludeInNetConditionGroup(GetSessionNetGroup());
+	}
+
+	FInventoryOperationResult Result = FInventoryOperationResult::Ok();
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_OpenContainer, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("%s (%d open)"), *Viewer->GetName(), Sessions.Num()));
+	return Result;
+}
+
+void UInventoryComponent::RemoveSession(APlayerController* Viewer)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	const int32 Removed = Sessions.RemoveAllSwap([Viewer](const FContainerSession& Session)
+	{
+		return Session.Viewer.Get() == Viewer;
+	});
+
+	if (Removed == 0)
+	{
+		return;
+	}
+
+	// The owner keeps receiving its own on-demand groups after closing them
+	if (IsValid(Viewer) && Viewer != OwnerSessionViewer.Get())
+	{
+		Viewer->RemoveFromNetConditionGroup(GetSessionNetGroup());
+	}
+
+	FInventoryOperationResult Result = FInventoryOperationResult::Ok();
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_CloseContainer, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("%s (%d open)"), *GetNameSafe(Viewer), Sessions.Num()));
+}
+
+void UInventoryComponent::UpdateSessions()
+{
+	// Containers without on-demand groups have nothing to filter
+	if (!OnDemandSlots && Sessions.Num() == 0)
+	{
+		return;
+	}
+
+	const FName NetGroup = GetSessionNetGroup();
+
+	// Ownership changes with pickups and possession, so the owner's membership follows it here
+	APlayerController* OwnerViewer = GetOwningController();
+	APlayerController* PreviousOwnerViewer = OwnerSessionViewer.Get();
+	if (OwnerViewer != PreviousOwnerViewer)
+	{
+		const bool bPreviousHasSession = Sessions.ContainsByPredicate([PreviousOwnerViewer](const FContainerSession& Session)
+		{
+			return Session.Viewer.Get() == PreviousOwnerViewer;
+		});
+		if (PreviousOwnerViewer && !bPreviousHasSession)
+		{
+			PreviousOwnerViewer->RemoveFromNetConditionGroup(NetGroup);
+		}
+		if (OwnerViewer)
+		{
+			OwnerViewer->IncludeInNetConditionGroup(NetGroup);
+		}
+		OwnerSessionViewer = OwnerViewer;
+	}
+
+	for (int32 i = Sessions.Num() - 1; i >= 0; --i)
+	{
+		APlayerController* Viewer = Sessions[i].Viewer.Get();
+		UInventoryComponent* ViewerInventory = Sessions[i].ViewerInventory.Get();
+		if (Viewer && ViewerInventory && IsInSessionRange(Viewer))
+		{
+			continue;
+		}
+
+		if (Viewer && ViewerInventory)
+		{
+			ViewerInventory->OpenContainers.Remove(this);
+			ViewerInventory->ClientContainerClosed(this, TEXT("Out of range"));
+		}
+
+		Sessions.RemoveAtSwap(i);
+		if (Viewer && Viewer != OwnerViewer)
+		{
+			Viewer->RemoveFromNetConditionGroup(NetGroup);
+		}
+	}
+}
+
+void UInventoryComponent::EndSessions()
+{
+	const FName NetGroup = GetSessionNetGroup();
+
+	for (const FContainerSession& Session : Sessions)
+	{
+		if (APlayerController* Viewer = Session.Viewer.Get())
+		{
+			Viewer->RemoveFromNetConditionGroup(NetGroup);
+		}
+	}
+	Sessions.Reset();
+
+	if (APlayerController* OwnerViewer = OwnerSessionViewer.Get())
+	{
+		OwnerViewer->RemoveFromNetConditionGroup(NetGroup);
+	}
+	OwnerSessionViewer.Reset();
+
+	if (OnDemandSlots)
+	{
+		// Items outlive the component when transferred out, so they must not stay in this group
+		OnDemandSlots->Slots.ForEachEntry([this](const FInventoryReplicatedSlot& Entry)
+		{
+			if (Entry.Item)
+			{
+				Entry.Item->UnregisterReplicatedSubObjects(this);
+			}
+		});
+
+		RemoveReplicatedSubObject(OnDemandSlots);
+		if (UNetworkSubsystem* NetSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UNetworkSubsystem>() : nullptr)
+		{
+			NetSubsystem->GetNetConditionGroupManager().UnregisterSubObjectFromGroup(OnDemandSlots, NetGroup);
+		}
+	}
+}
+
+void UInventoryComponent::UpdateContainerSummary()
+{
+	FInventoryContainerSummary NewSummary;
+	for (const FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroups())
+	{
+		NewSummary.ItemCount += Group.GetTotalStackUnits();
+		NewSummary.OccupiedSlots += Group.GetOccupiedSlotCount();
+		NewSummary.TotalSlots += Group.GetMaxSlotSize();
+	}
+
+	if (NewSummary != ContainerSummary)
+	{
+		ContainerSummary = NewSummary;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, ContainerSummary, this);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+}
+
+void UInventoryComponent::OpenContainer(UInventoryComponent* Container)
+{
+	if (!IsValid(Container) || Container == this)
+	{
+		return;
+	}
+
+	const AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority())
+	{
+		// Without a player (e.g. server-side AI) there is no connection to subscribe; the server already holds every group
+		if (APlayerController* Viewer = GetOwningController())
+		{
+			const FInventoryOperationResult Result = Container->AddSession(Viewer, this);
+			if (!Result.bSuccess)
+			{
+				UE_LOG(LogInventory, Log, TEXT("OpenContainer: %s refused: %s"), *Container->GetName(), *Result.Message);
+				return;
+			}
+		}
+	}
+	else
+	{
+		ServerOpenContainer(Container);
+		Container->ReapplyOnDemandContents();
+	}
+
+	OpenContainers.AddUnique(Container);
+	OnContainerSessionChanged.Broadcast(Container, true);
+}
+
+void UInventoryComponent::CloseContainer(UInventoryComponent* Container)
+{
+	if (!Container)
+	{
+		return;
+	}
+
+	const bool bWasOpen = OpenContainers.Remove(Container) > 0;
+
+	const AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority())
+	{
+		if (APlayerController* Viewer = GetOwningController())
+		{
+			Container->RemoveSession(Viewer);
+		}
+	}
+	else if (IsValid(Container))
+	{
+		ServerCloseContainer(Container);
+
+		// The owner keeps its own on-demand groups
+		if (Container->GetOwningController() != GetOwningController())
+		{
+			Container->ClearOnDemandContents();
+		}
+	}
+
+	if (bWasOpen)
+	{
+		OnContainerSessionChanged.Broadcast(Container, false);
+	}
+}
+
+bool UInventoryComponent::IsContainerOpen(const UInventoryComponent* Container) const
+{
+	return Container && OpenContainers.ContainsByPredicate([Container](const TWeakObjectPtr<UInventoryComponent>& Open)
+	{
+		return Open.Get() == Container;
+	});
+}
+
+void UInventoryComponent::ServerOpenContainer_Implementation(UInventoryComponent* Container)
+{
+	if (!IsValid(Container) || Container == this)
+	{
+		return;
+	}
+
+	const FInventoryOperationResult Result = Container->AddSession(GetOwningController(), this);
+	if (Result.bSuccess)
+	{
+		OpenContainers.AddUnique(Container);
+	}
+	else
+	{
+		ClientContainerClosed(Container, Result.Message);
+	}
+}
+
+void UInventoryComponent::ServerCloseContainer_Implementation(UInventoryComponent* Container)
+{
+	OpenContainers.Remove(Container);
+
+	if (IsValid(Container))
+	{
+		Container->RemoveSession(GetOwningController());
+	}
+}
+
+void UInventoryComponent::ClientContainerClosed_Implementation(UInventoryComponent* Container, const FString& Reason)
+{
+	UE_LOG(LogInventory, Log, TEXT("Container %s closed by server: %s"), *GetNameSafe(Container), *Reason);
+
+	OpenContainers.Remove(Container);
+
+	if (IsValid(Container) && Container->GetOwningController() != GetOwningController())
+	{
+		Container->ClearOnDemandContents();
+	}
+
+	OnContainerSessionChanged.Broadcast(Container, false);
+}
+
+void UInventoryComponent::ClearOnDemandContents()
+{
+	TArray<TPair<int32, int32>> OccupiedSlots;
+	const TArray<FInventorySlots>& Groups = InventorySlotsGroup.GetInventoryGroups();
+	for (int32 GroupIdx = 0; GroupIdx < Groups.Num(); ++GroupIdx)
+	{
+		if (Groups[GroupIdx].GetReplicationPolicy() == EInventoryGroupReplication::IGR_OnDemand)
+		{
+			Groups[GroupIdx].ForEachOccupiedSlot([GroupIdx, &OccupiedSlots](int32 SlotIndex, const FInventorySlot&)
+			{
+				OccupiedSlots.Emplace(GroupIdx, SlotIndex);
+			});
+		}
+	}
+
+	bOnDemandContentsHidden = false;
+	for (const TPair<int32, int32>& Slot : OccupiedSlots)
+	{
+		ApplyReplicatedSlot(Slot.Key, Slot.Value, nullptr, nullptr, 0);
+	}
+	bOnDemandContentsHidden = true;
+}
+
+void UInventoryComponent::ReapplyOnDemandContents()
+{
+	bOnDemandContentsHidden = false;
+
+	if (OnDemandSlots)
+	{
+		OnDemandSlots->Slots.ForEachEntry([this](const FInventoryReplicatedSlot& Entry)
+		{
+			if (Entry.IsResolved())
+			{
+				ApplyReplicatedSlot(Entry.GroupIndex, Entry.SlotIndex, Entry.Item, Entry.ValueItemClass, Entry.Quantity);
+			}
+		});
+	}
+}
@@ -1,7 +1,12 @@
 #include "InventoryComponent.h"
 #include "InventorySystem.h"
 #include "InventoryDebugSubsystem.h"
+#include "InventoryOnDemandSlots.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/NetworkSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/ActorChannel.h"
 #include "Modules/InventoryModuleBase.h"
 #include "PoolSystem/ItemPoolSubsystem.h"
@@ -11,55 +16,907 @@ UInventoryComponent::UInventoryComponent()
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	bAutoStackItems = true;
+	ReplicatedSlots.Owner = this;
+	OwnerReplicatedSlots.Owner = this;
+	bReplicateUsingRegisteredSubObjectList = true;
 	SetIsReplicatedByDefault(true);
 }
 
 void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(UInventoryComponent, InventorySlotsGroup);
-	DOREPLIFETIME(UInventoryComponent, InstalledModules);
+
+	// All of these are marked dirty explicitly, so idle inventories are skipped by the net driver
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, InventorySlotsGroup, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, InstalledModules, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, ValueItemClasses, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, ReplicatedSlots, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, OnDemandSlots, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, ContainerSummary, PushParams);
+
+	FDoRepLifetimeParams OwnerPushParams;
+	OwnerPushParams.bIsPushBased = true;
+	OwnerPushParams.Condition = COND_OwnerOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, OwnerReplicatedSlots, OwnerPushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, LastServerPredictionKey, OwnerPushParams);
+}
+
+void UInventoryComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	SyncReplicatedSlots();
+	UpdateSessions();
+
+	++NetMetrics.NetUpdates;
+	NetMetrics.PreReplicationMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+FInventoryReplicatedSlotArray& UInventoryComponent::GetSlotMirror(const FInventorySlots& Group)
+{
+	switch (Group.GetReplicationPolicy())
+	{
+	case EInventoryGroupReplication::IGR_OwnerOnly:
+		return OwnerReplicatedSlots;
+	case EInventoryGroupReplication::IGR_OnDemand:
+		if (!OnDemandSlots)
+		{
+			OnDemandSlots = NewObject<UInventoryOnDemandSlots>(this);
+			AddReplicatedSubObject(OnDemandSlots, COND_NetGroup);
+			if (UNetworkSubsystem* NetSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UNetworkSubsystem>() : nullptr)
+			{
+				NetSubsystem->GetNetConditionGroupManager().RegisterSubObjectInGroup(OnDemandSlots, GetSessionNetGroup());
+			}
+			MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, OnDemandSlots, this);
+			++NetMetrics.PropertiesMarkedDirty;
+		}
+		return OnDemandSlots->Slots;
+	default:
+		return ReplicatedSlots;
+	}
+}
+
+ELifetimeCondition UInventoryComponent::GetReplicationCondition(const FInventorySlots& Group)
+{
+	switch (Group.GetReplicationPolicy())
+	{
+	case EInventoryGroupReplication::IGR_OwnerOnly:
+		return COND_OwnerOnly;
+	case EInventoryGroupReplication::IGR_OnDemand:
+		return COND_NetGroup;
+	default:
+		return COND_None;
+	}
+}
+
+void UInventoryComponent::ForEachSlotMirror(TFunctionRef<void(FInventoryReplicatedSlotArray&)> Visitor)
+{
+	Visitor(ReplicatedSlots);
+	Visitor(OwnerReplicatedSlots);
+	if (OnDemandSlots)
+	{
+		Visitor(OnDemandSlots->Slots);
+	}
+}
+
+void UInventoryComponent::SyncReplicatedSlots()
+{
+	// Slot structs have no owner to dirty, so layout and content changes are detected here by version
+	const uint64 LayoutVersion = InventorySlotsGroup.GetLayoutVersion();
+	const bool bLayoutChanged = LayoutVersion != SyncedLayoutVersion;
+	if (bLayoutChanged)
+	{
+		SyncedLayoutVersion = LayoutVersion;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InventorySlotsGroup, this);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+
+	const uint64 ContentVersion = InventorySlotsGroup.GetContentVersion();
+	if (!bLayoutChanged && ContentVersion == SyncedContentVersion)
+	{
+		return;
+	}
+	SyncedContentVersion = ContentVersion;
+
+	UpdateContainerSummary();
+
+	const int32 PublicKeyBefore = ReplicatedSlots.ArrayReplicationKey;
+	const int32 OwnerKeyBefore = OwnerReplicatedSlots.ArrayReplicationKey;
+	const int32 OnDemandKeyBefore = OnDemandSlots ? OnDemandSlots->Slots.ArrayReplicationKey : 0;
+	TArrayView<FInventorySlots> Groups = InventorySlotsGroup.GetInventoryGroupsMutable();
+
+	// Items that left or entered a slot; an item can do both in one sync when it moves between slots
+	TArray<UItemBase*> DepartedItems;
+	TMap<UItemBase*, ELifetimeCondition> ArrivedItems;
+
+	if (bLayoutChanged)
+	{
+		// Group indices or replication policies may have changed, so rebuild every entry
+		auto CollectDeparted = [&DepartedItems](const FInventoryReplicatedSlot& Entry)
+		{
+			DepartedItems.Add(Entry.Item);
+		};
+		ForEachSlotMirror([&CollectDeparted](FInventoryReplicatedSlotArray& Mirror)
+		{
+			Mirror.ForEachEntry(CollectDeparted);
+			Mirror.Reset();
+		});
+
+		for (int32 GroupIdx = 0; GroupIdx < Groups.Num(); ++GroupIdx)
+		{
+			FInventoryReplicatedSlotArray& Mirror = GetSlotMirror(Groups[GroupIdx]);
+			const ELifetimeCondition Condition = GetReplicationCondition(Groups[GroupIdx]);
+
+			Groups[GroupIdx].ConsumeChangedSlots(EInventorySlotChangeConsumer::Replication, [](int32) {});
+			Groups[GroupIdx].ForEachOccupiedSlot([GroupIdx, &Mirror, Condition, &ArrivedItems](int32 SlotIndex, const FInventorySlot& Slot)
+			{
+				if (Slot.GetItem())
+				{
+					ArrivedItems.Add(Slot.GetItem(), Condition);
+				}
+				Mirror.SetSlot(GroupIdx, SlotIndex, Slot.GetItem(), Slot.GetValueItemClass(), Slot.GetCurrentStackSize());
+			});
+		}
+	}
+	else
+	{
+		for (int32 GroupIdx = 0; GroupIdx < Groups.Num(); ++GroupIdx)
+		{
+			const FInventorySlots& Group = Groups[GroupIdx];
+			FInventoryReplicatedSlotArray& Mirror = GetSlotMirror(Group);
+			const ELifetimeCondition Condition = GetReplicationCondition(Group);
+
+			Groups[GroupIdx].ConsumeChangedSlots(EInventorySlotChangeConsumer::Replication,
+				[GroupIdx, &Group, &Mirror, Condition, &DepartedItems, &ArrivedItems](int32 SlotIndex)
+			{
+				const FInventorySlot& Slot = Group.GetSlots()[SlotIndex];
+				UItemBase* Item = Slot.IsEmpty() ? nullptr : Slot.GetItem();
+				UItemBase* Previous = Mirror.FindItem(GroupIdx, SlotIndex);
+				if (Previous != Item)
+				{
+					if (Previous)
+					{
+						DepartedItems.Add(Previous);
+					}
+					if (Item)
+					{
+						ArrivedItems.Add(Item, Condition);
+					}
+				}
+
+				Mirror.SetSlot(GroupIdx, SlotIndex, Item, Slot.GetValueItemClass(), Slot.GetCurrentStackSize());
+			});
+		}
+	}
+
+	for (UItemBase* Item : DepartedItems)
+	{
+		if (Item && !ArrivedItems.Contains(Item))
+		{
+			Item->UnregisterReplicatedSubObjects(this);
+		}
+	}
+
+	// Re-registering with a different condition moves an item that changed groups to the new policy
+	for (const TPair<UItemBase*, ELifetimeCondition>& Pair : ArrivedItems)
+	{
+		Pair.Key->RegisterReplicatedSubObjects(this, Pair.Value, GetSessionNetGroup());
+	}
+	NetMetrics.SubobjectsRegistered += ArrivedItems.Num();
+
+	if (ReplicatedSlots.ArrayReplicationKey != PublicKeyBefore)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, ReplicatedSlots, this);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+	if (OwnerReplicatedSlots.ArrayReplicationKey != OwnerKeyBefore)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, OwnerReplicatedSlots, this);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+	if (OnDemandSlots && OnDemandSlots->Slots.ArrayReplicationKey != OnDemandKeyBefore)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryOnDemandSlots, Slots, OnDemandSlots);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+}
+
+int32 UInventoryComponent::FindOrAddValueItemClass(TSubclassOf<UItemBase> ItemClass)
+{
+	int32 ClassIndex = ValueItemClasses.Find(ItemClass);
+	if (ClassIndex == INDEX_NONE)
+	{
+		ClassIndex = ValueItemClasses.Add(ItemClass);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, ValueItemClasses, this);
+		++NetMetrics.PropertiesMarkedDirty;
+	}
+	return ClassIndex;
+}
+
+void UInventoryComponent::OnRep_ValueItemClasses()
+{
+	ForEachSlotMirror([](FInventoryReplicatedSlotArray& Mirror)
+	{
+		Mirror.ResolveValueItemClasses();
+	});
+}
+
+FInventoryReplicationStats UInventoryComponent::GetReplicationStats() const
+{
+	FInventoryReplicationStats Stats = ReplicatedSlots.GetNetStats();
+	Stats.Accumulate(OwnerReplicatedSlots.GetNetStats());
+	if (OnDemandSlots)
+	{
+		Stats.Accumulate(OnDemandSlots->Slots.GetNetStats());
+	}
+	return Stats;
+}
+
+void UInventoryComponent::ResetReplicationStats()
+{
+	ForEachSlotMirror([](FInventoryReplicatedSlotArray& Mirror)
+	{
+		Mirror.ResetNetStats();
+	});
+	NetMetrics.Reset();
+}
+
+void UInventoryComponent::BroadcastItemAdded(UItemBase* Item, int32 TypeID, int32 SlotIndex, const FInventorySlotHandle& Handle)
+{
+	OnItemAdded.Broadcast(Item, TypeID, SlotIndex);
+	OnItemAddedWithHandle.Broadcast(Item, TypeID, SlotIndex, Handle);
+}
+
+void UInventoryComponent::BroadcastItemRemoved(UItemBase* Item, int32 TypeID, int32 SlotIndex, const FInventorySlotHandle& Handle)
+{
+	OnItemRemoved.Broadcast(Item, TypeID, SlotIndex);
+	OnItemRemovedWithHandle.Broadcast(Item, TypeID, SlotIndex, Handle);
+}
+
+void UInventoryComponent::BroadcastItemStackChanged(UItemBase* Item, int32 TypeID, int32 SlotIndex, int32 OldAmount,
+                                                    int32 NewAmount, const FInventorySlotHandle& Handle)
+{
+	OnItemStackChanged.Broadcast(Item, TypeID, SlotIndex, OldAmount, NewAmount);
+	OnItemStackChangedWithHandle.Broadcast(Item, TypeID, SlotIndex, OldAmount, NewAmount, Handle);
+}
+
+void UInventoryComponent::ApplyReplicatedSlot(int32 GroupIndex, int32 SlotIndex, UItemBase* Item,
+                                              TSubclassOf<UItemBase> ValueItemClass, int32 Quantity, bool bBroadcast)
+{
+	FInventorySlots* Group = InventorySlotsGroup.GetGroupByIndex(GroupIndex);
+	const FInventorySlot* Slot = Group ? Group->GetSlotAtIndex(SlotIndex) : nullptr;
+	if (!Slot)
+	{
+		return;
+	}
+
+	// The slot shows a prediction; the entry stays in the mirror and is applied when the server acknowledges it
+	if (PredictedSlots.Contains(TPair<int32, int32>(GroupIndex, SlotIndex)))
+	{
+		return;
+	}
+
+	// Closed locally; late deltas from the session stay in the mirror for the next open
+	if (bOnDemandContentsHidden && Group->GetReplicationPolicy() == EInventoryGroupReplication::IGR_OnDemand)
+	{
+		return;
+	}
+
+	UItemBase* OldItem = Slot->IsEmpty() ? nullptr : Slot->GetItem();
+	const bool bWasValueStack = Slot->IsValueStack();
+	const int32 OldQuantity = Slot->GetCurrentStackSize();
+	const FInventorySlotHandle OldHandle = InventorySlotsGroup.MakeSlotHandle(GroupIndex, SlotIndex);
+
+	if (!Item && ValueItemClass)
+	{
+		Group->SetValueStackContents(SlotIndex, ValueItemClass, Quantity);
+	}
+	else
+	{
+		Group->SetSlotContents(SlotIndex, Item, Quantity);
+	}
+
+	if (!bBroadcast)
+	{
+		return;
+	}
+
+	UItemBase* NewItem = Slot->IsEmpty() ? nullptr : Slot->GetItem();
+	const int32 TypeID = InventorySlotsGroup.GetTypeIDForGroupIndex(GroupIndex);
+	const FInventorySlotHandle NewHandle = InventorySlotsGroup.MakeSlotHandle(GroupIndex, SlotIndex);
+
+	if (bWasValueStack || Slot->IsValueStack())
+	{
+		TArray<FInventorySlotHandle> ChangedSlots;
+		ChangedSlots.Add(NewHandle);
+		OnSlotsChanged.Broadcast(ChangedSlots);
+		if (OldItem)
+		{
+			BroadcastItemRemoved(OldItem, TypeID, SlotIndex, OldHandle);
+		}
+		if (NewItem)
+		{
+			BroadcastItemAdded(NewItem, TypeID, SlotIndex, NewHandle);
+		}
+		return;
+	}
+
+	if (OldItem == NewItem)
+	{
+		if (NewItem && OldQuantity != Slot->GetCurrentStackSize())
+		{
+			BroadcastItemStackChanged(NewItem, TypeID, SlotIndex, OldQuantity, Slot->GetCurrentStackSize(), NewHandle);
+		}
+		return;
+	}
+
+	if (OldItem)
+	{
+		BroadcastItemRemoved(OldItem, TypeID, SlotIndex, OldHandle);
+	}
+	if (NewItem)
+	{
+		BroadcastItemAdded(NewItem, TypeID, SlotIndex, NewHandle);
+	}
+}
+
+bool UInventoryComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
+{
+	// Only reached when the owning actor does not use the registered subobject list
+	const double StartTime = FPlatformTime::Seconds();
+	bool bWroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+
+	auto ReplicateEntry = [&](const FInventoryReplicatedSlot& Entry)
+	{
+		if (IsValid(Entry.Item))
+		{
+			if (Channel->ReplicateSubobject(Entry.Item, *Bunch, *RepFlags))
+			{
+				bWroteSomething = true;
+				++NetMetrics.SubobjectsWritten;
+			}
+			bWroteSomething |= Entry.Item->ReplicateSubobjects(Channel, Bunch, RepFlags);
+		}
+	};
+
+	ReplicatedSlots.ForEachEntry(ReplicateEntry);
+	if (RepFlags->bNetOwner)
+	{
+		OwnerReplicatedSlots.ForEachEntry(ReplicateEntry);
+	}
+
+	// Same membership test as the session net group: the owner, or a viewer with an open session
+	if (OnDemandSlots && Channel->Connection)
+	{
+		const APlayerController* Viewer = Channel->Connection->PlayerController;
+		const bool bHasSession = RepFlags->bNetOwner || Sessions.ContainsByPredicate([Viewer](const FContainerSession& Session)
+		{
+			return Session.Viewer.Get() == Viewer;
+		});
+		if (bHasSession)
+		{
+			if (Channel->ReplicateSubobject(OnDemandSlots, *Bunch, *RepFlags))
+			{
+				bWroteSomething = true;
+				++NetMetrics.SubobjectsWritten;
+			}
+			OnDemandSlots->Slots.ForEachEntry(ReplicateEntry);
+		}
+	}
+
+	for (UInventoryModuleBase* Module : InstalledModules)
+	{
+		if (IsValid(Module))
+		{
+			if (Channel->ReplicateSubobject(Module, *Bunch, *RepFlags))
+			{
+				bWroteSomething = true;
+				++NetMetrics.SubobjectsWritten;
+			}
+		}
+	}
+
+	NetMetrics.ReplicateSubobjectsMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return bWroteSomething;
+}
+
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroupsMutable())
+	{
+		if (Group.GetSlots().Num() == 0 && Group.GetMaxSlotSize() > 0)
+		{
+			Group.InitializeInventory(Group.GetMaxSlotSize(), Group.GetTypeIDMap());
+		}
+	}
+
+	InventorySlotsGroup.RebuildCache();
+
+	if (bDeferChangeNotifications)
+	{
+		ResetChangeTracking();
+		BindEndOfFrameFlush();
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		if (UInventoryDebugSubsystem* DS = GI->GetSubsystem<UInventoryDebugSubsystem>())
+		{
+			DS->RegisterInventory(this);
+		}
+	}
+#endif
+}
+
+void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindEndOfFrameFlush();
+
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		EndSessions();
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		if (UInventoryDebugSubsystem* DS = GI->GetSubsystem<UInventoryDebugSubsystem>())
+		{
+			DS->UnregisterInventory(this);
+		}
+	}
+#endif
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInventoryComponent::SetDeferChangeNotifications(bool bDefer)
+{
+	if (bDeferChangeNotifications == bDefer)
+	{
+		return;
+	}
+
+	bDeferChangeNotifications = bDefer;
+
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	if (bDefer)
+	{
+		ResetChangeTracking();
+		BindEndOfFrameFlush();
+	}
+	else
+	{
+		FlushChangeSet();
+		UnbindEndOfFrameFlush();
+	}
+}
+
+void UInventoryComponent::BindEndOfFrameFlush()
+{
+	if (!PostActorTickHandle.IsValid())
+	{
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+			this, &UInventoryComponent::OnWorldPostActorTick);
+	}
+}
+
+void UInventoryComponent::UnbindEndOfFrameFlush()
+{
+	if (PostActorTickHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+		PostActorTickHandle.Reset();
+	}
+}
+
+void UInventoryComponent::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		FlushChangeSet();
+	}
+}
+
+void UInventoryComponent::ResetChangeTracking()
+{
+	FlushedItemTotals.Reset();
+	InventorySlotsGroup.ForEachGlobalItemTotal([this](uint64 ItemKey, int32 Total)
+	{
+		FlushedItemTotals.Add(ItemKey, Total);
+	});
+
+	for (const FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroups())
+	{
+		Group.ForEachOccupiedSlot([this](int32 SlotIndex, const FInventorySlot& Slot)
+		{
+			const FItemDefinition& Definition = Slot.GetItemPrototype()->GetItemDefinition();
+			KnownItemIDs.FindOrAdd(Definition.GetItemKey(), Definition.GetItemID());
+		});
+	}
+
+	TArray<FInventorySlotHandle> Discarded;
+	InventorySlotsGroup.ConsumeChangedSlots(EInventorySlotChangeConsumer::Notify, Discarded);
+	FlushedContentVersion = InventorySlotsGroup.GetContentVersion();
+}
+
+bool UInventoryComponent::FlushChangeSet()
+{
+	const uint64 ContentVersion = InventorySlotsGroup.GetContentVersion();
+	if (ContentVersion == FlushedContentVersion)
+	{
+		return false;
+	}
+	FlushedContentVersion = ContentVersion;
+
+	FInventoryChangeSet ChangeSet;
+	InventorySlotsGroup.ConsumeChangedSlots(EInventorySlotChangeConsumer::Notify, ChangeSet.ChangedSlots);
+
+	for (const FInventorySlotHandle& Handle : ChangeSet.ChangedSlots)
+	{
+		const FInventorySlot* Slot = InventorySlotsGroup.ResolveHandle(Handle);
+		if (Slot && !Slot->IsEmpty())
+		{
+			const FItemDefinition& Definition = Slot->GetItemPrototype()->GetItemDefinition();
+			KnownItemIDs.FindOrAdd(Definition.GetItemKey(), Definition.GetItemID());
+		}
+	}
+
+	TMap<uint64, int32> CurrentTotals;
+	CurrentTotals.Reserve(FlushedItemTotals.Num());
+	InventorySlotsGroup.ForEachGlobalItemTotal([&CurrentTotals](uint64 ItemKey, int32 Total)
+	{
+		CurrentTotals.Add(ItemKey, Total);
+	});
+
+	auto AddDelta = [this, &ChangeSet](uint64 ItemKey, int32 Delta)
+	{
+		if (Delta != 0)
+		{
+			const FString* ItemID = KnownItemIDs.Find(ItemKey);
+			FInventoryItemDelta& ItemDelta = ChangeSet.ItemDeltas.AddDefaulted_GetRef();
+			ItemDelta.ItemID = ItemID ? *ItemID : FString();
+			ItemDelta.Delta = Delta;
+		}
+	};
+
+	for (const TPair<uint64, int32>& Pair : CurrentTotals)
+	{
+		AddDelta(Pair.Key, Pair.Value - FlushedItemTotals.FindRef(Pair.Key));
+	}
+	for (const TPair<uint64, int32>& Pair : FlushedItemTotals)
+	{
+		if (!CurrentTotals.Contains(Pair.Key))
+		{
+			AddDelta(Pair.Key, -Pair.Value);
+		}
+	}
+
+	FlushedItemTotals = MoveTemp(CurrentTotals);
+
+	if (ChangeSet.IsEmpty())
+	{
+		return false;
+	}
+
+	OnInventoryChanged.Broadcast(ChangeSet);
+	return true;
+}
+
+void UInventoryComponent::OnRep_InventorySlotsGroup()
+{
+	InventorySlotsGroup.InvalidateCache();
+
+	// Every slot is refilled from the server's entries below, which rolls back all predicted writes;
+	// ReconcilePredictions then replays what is still in flight against the new layout
+	PredictedSlots.Reset();
+
+	// Slots are not part of the layout and groups may have shifted; refill every group from the replicated entries
+	for (FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroupsMutable())
+	{
+		if (Group.GetSlots().Num() != Group.GetMaxSlotSize())
+		{
+			Group.InitializeInventory(Group.GetMaxSlotSize(), Group.GetTypeIDMap());
+		}
+		else
+		{
+			Group.ClearAllSlots();
+		}
+	}
+
+	auto ReapplyEntry = [this](const FInventoryReplicatedSlot& Entry)
+	{
+		if (!Entry.IsResolved())
+		{
+			return;
+		}
+		ApplyReplicatedSlot(Entry.GroupIndex, Entry.SlotIndex, Entry.Item, Entry.ValueItemClass, Entry.Quantity, false);
+	};
+	ForEachSlotMirror([&ReapplyEntry](FInventoryReplicatedSlotArray& Mirror)
+	{
+		Mirror.ForEachEntry(ReapplyEntry);
+	});
+
+	InventorySlotsGroup.MarkSlotIndexesDirty();
+
+	ReconcilePredictions(LastServerPredictionKey, true);
+}
+
+bool UInventoryComponent::CanPredict() const
+{
+	// Server RPCs need an owning connection, which only the owning client has
+	const AActor* Owner = GetOwner();
+	return Owner && !Owner->HasAuthority() && Owner->GetNetConnection() != nullptr;
+}
+
+FInventoryOperationResult UInventoryComponent::PredictOperation(FInventoryPredictedRequest Request)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	Request.PredictionKey = ++LastPredictionKey;
+
+	FPendingPrediction Pending;
+	Pending.Request = Request;
+	const bool bPredicted = ApplyPredictedOperation(Request, Pending);
+	if (bPredicted)
+	{
+		TArray<FInventorySlotHandle> ChangedSlots;
+		for (const TPair<int32, int32>& Touched : Pending.TouchedSlots)
+		{
+			++PredictedSlots.FindOrAdd(Touched);
+			ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(Touched.Key, Touched.Value));
+		}
+		PendingPredictions.Add(MoveTemp(Pending));
+		OnSlotsChanged.Broadcast(ChangedSlots);
+	}
+
+	ServerExecutePredicted(Request);
+
+	EInventoryOperationType OperationType = EInventoryOperationType::IOT_TransferItem;
+	if (Request.Operation == EInventoryPredictedOperation::IPO_SwapSlots)
+	{
+		OperationType = EInventoryOperationType::IOT_SwapSlots;
+	}
+	else if (Request.Operation == EInventoryPredictedOperation::IPO_SplitStack)
+	{
+		OperationType = EInventoryOperationType::IOT_SplitStack;
+	}
+
+	FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+	TrackInventoryOperation(GetWorld(), OperationType, OkResult,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Key:%d %s"), Request.PredictionKey, bPredicted ? TEXT("Predicted") : TEXT("Sent unpredicted")));
+	return OkResult;
+}
+
+bool UInventoryComponent::ApplyPredictedOperation(const FInventoryPredictedRequest& Request, FPendingPrediction& OutPending)
+{
+	const int32 FromGroupIdx = InventorySlotsGroup.GetGroupIndexByID(Request.FromTypeID);
+	FInventorySlots* FromGroup = InventorySlotsGroup.GetGroupByIndex(FromGroupIdx);
+	const FInventorySlot* Source = FromGroup ? FromGroup->GetSlotAtIndex(Request.FromIndex) : nullptr;
+	if (!Source || Source->IsEmpty())
+	{
+		return false;
+	}
+
+	switch (Request.Operation)
+	{
+	case EInventoryPredictedOperation::IPO_TransferItem:
+		{
+			const int32 ToGroupIdx = InventorySlotsGroup.GetGroupIndexByID(Request.ToTypeID);
+			FInventorySlots* ToGroup = InventorySlotsGroup.GetGroupByIndex(ToGroupIdx);
+			const FInventorySlot* Dest = ToGroup ? ToGroup->GetSlotAtIndex(Request.ToIndex) : nullptr;
+			const UItemBase* Prototype = Source->GetItemPrototype();
+			if (!Dest || !ToGroup->IsTypeSupported(Prototype))
+			{
+				return false;
+			}
+
+			// Only a move into an empty slot or a merge of the whole stack is certain to match the server
+			const int32 Quantity = Source->GetCurrentStackSize();
+			const bool bFullMerge = Prototype->IsStackable() && Dest->CanStackItem(Prototype)
+				&& Dest->GetAvailableSpace() >= Quantity;
+			if (!Dest->IsEmpty() && !bFullMerge)
+			{
+				return false;
+			}
+
+			if (FromGroup->TransferSlotContents(Request.FromIndex, *ToGroup, Request.ToIndex, Quantity) != Quantity)
+			{
+				return false;
+			}
+
+			OutPending.TouchedSlots.Emplace(FromGroupIdx, Request.FromIndex);
+			OutPending.TouchedSlots.Emplace(ToGroupIdx, Request.ToIndex);
+			return true;
+		}
+
+	case EInventoryPredictedOperation::IPO_SwapSlots:
+		{
+			if (!FromGroup->SwapSlots(Request.FromIndex, Request.ToIndex).bSuccess)
+			{
+				return false;
+			}
+
+			OutPending.TouchedSlots.Emplace(FromGroupIdx, Request.FromIndex);
+			OutPending.TouchedSlots.Emplace(FromGroupIdx, Request.ToIndex);
+			return true;
+		}
+
+	case EInventoryPredictedOperation::IPO_SplitStack:
+		{
+			const FInventorySlot* Target = FromGroup->GetSlotAtIndex(Request.ToIndex);
+			const int32 StackSize = Source->GetCurrentStackSize();
+			if (!Target || !Target->IsEmpty() || !Source->GetItemPrototype()->IsStackable()
+				|| Request.Quantity <= 0 || Request.Quantity >= StackSize)
+			{
+				return false;
+			}
+
+			// The split-off object only exists once the server creates it, so object stacks are sent unpredicted
+			if (!Source->IsValueStack()
+				|| !FromGroup->SplitStack(Request.FromIndex, Request.ToIndex, Request.Quantity).bSuccess)
+			{
+				return false;
+			}
+
+			OutPending.TouchedSlots.Emplace(FromGroupIdx, Request.FromIndex);
+			OutPending.TouchedSlots.Emplace(FromGroupIdx, Request.ToIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FInventoryOperationResult UInventoryComponent::ExecuteRequest(const FInventoryPredictedRequest& Request)
+{
+	switch (Request.Operation)
+	{
+	case EInventoryPredictedOperation::IPO_TransferItem:
+		return TransferItem(Request.FromTypeID, Request.FromIndex, Request.ToTypeID, Request.ToIndex);
+	case EInventoryPredictedOperation::IPO_SwapSlots:
+		return SwapSlots(Request.FromTypeID, Request.FromIndex, Request.ToIndex);
+	case EInventoryPredictedOperation::IPO_SplitStack:
+		return SplitStack(Request.FromTypeID, Request.FromIndex, Request.ToIndex, Request.Quantity);
+	}
+
+	return FInventoryOperationResult::Fail(TEXT("Unknown predicted operation"));
 }
 
-bool UInventoryComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
+void UInventoryComponent::ServerExecutePredicted_Implementation(const FInventoryPredictedRequest& Request)
 {
-	bool bWroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	const FInventoryOperationResult Result = ExecuteRequest(Request);
+	if (!Result.bSuccess)
+	{
+		ClientRejectPrediction(Request.PredictionKey, Result.Message);
+	}
 
-	for (const FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroups())
+	// Replicates together with the slot entries this request changed, so the client reconciles against its result
+	LastServerPredictionKey = FMath::Max(LastServerPredictionKey, Request.PredictionKey);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, LastServerPredictionKey, this);
+	++NetMetrics.PropertiesMarkedDirty;
+}
+
+void UInventoryComponent::ClientRejectPrediction_Implementation(int32 PredictionKey, const FString& Reason)
+{
+	if (LocallyRejectedPredictionKeys.Remove(PredictionKey) > 0)
 	{
-		for (const FInventorySlot& Slot : Group.GetSlots())
+		return;
+	}
+
+	UE_LOG(LogInventory, Log, TEXT("Predicted operation %d rejected: %s"), PredictionKey, *Reason);
+	OnPredictionRejected.Broadcast(PredictionKey, Reason);
+}
+
+void UInventoryComponent::OnRep_LastServerPredictionKey()
+{
+	ReconcilePredictions(LastServerPredictionKey);
+}
+
+void UInventoryComponent::ReconcilePredictions(int32 AckedKey, bool bLayoutChanged)
+{
+	const int32 PendingBefore = PendingPredictions.Num();
+	TSet<TPair<int32, int32>> Restored;
+	if (!bLayoutChanged)
+	{
+		// After a layout change the touched indices may name other slots, and every slot was already restored
+		for (const FPendingPrediction& Pending : PendingPredictions)
 		{
-			if (IsValid(Slot.GetItem()))
-			{
-				bWroteSomething |= Channel->ReplicateSubobject(Slot.GetItem(), *Bunch, *RepFlags);
-			}
+			Restored.Append(Pending.TouchedSlots);
 		}
 	}
 
-	for (UInventoryModuleBase* Module : InstalledModules)
+	PendingPredictions.RemoveAll([AckedKey](const FPendingPrediction& Pending)
 	{
-		if (IsValid(Module))
+		return Pending.Request.PredictionKey <= AckedKey;
+	});
+	if (PendingPredictions.Num() == PendingBefore && !bLayoutChanged)
+	{
+		return;
+	}
+
+	// Back to the server's view of every predicted slot; the mirrors hold the latest entries even for skipped slots
+	TMap<TPair<int32, int32>, const FInventoryReplicatedSlot*> ServerEntries;
+	auto CollectEntry = [&Restored, &ServerEntries](const FInventoryReplicatedSlot& Entry)
+	{
+		const TPair<int32, int32> Key(Entry.GroupIndex, Entry.SlotIndex);
+		if (Restored.Contains(Key))
+		{
+			ServerEntries.Add(Key, &Entry);
+		}
+	};
+	ForEachSlotMirror([&CollectEntry](FInventoryReplicatedSlotArray& Mirror)
+	{
+		Mirror.ForEachEntry(CollectEntry);
+	});
+
+	PredictedSlots.Reset();
+	for (const TPair<int32, int32>& Key : Restored)
+	{
+		const FInventoryReplicatedSlot* const* Entry = ServerEntries.Find(Key);
+		if (Entry)
 		{
-			bWroteSomething |= Channel->ReplicateSubobject(Module, *Bunch, *RepFlags);
+			ApplyReplicatedSlot(Key.Key, Key.Value, (*Entry)->Item, (*Entry)->ValueItemClass, (*Entry)->Quantity, false);
+		}
+		else
+		{
+			ApplyReplicatedSlot(Key.Key, Key.Value, nullptr, nullptr, 0, false);
 		}
 	}
 
-	return bWroteSomething;
+	// Replay what is still in flight on top of the server state; a prediction that no longer applies is left to the server
+	TArray<FPendingPrediction> InFlight = MoveTemp(PendingPredictions);
+	PendingPredictions.Reset();
+	for (const FPendingPrediction& Pending : InFlight)
+	{
+		FPendingPrediction Replayed;
+		Replayed.Request = Pending.Request;
+		if (ApplyPredictedOperation(Pending.Request, Replayed))
+		{
+			Restored.Append(Replayed.TouchedSlots);
+			PendingPredictions.Add(MoveTemp(Replayed));
+		}
+		else if (bLayoutChanged)
+		{
+			const FString Reason = TEXT("Slot layout changed before the server confirmed the operation");
+			UE_LOG(LogInventory, Log, TEXT("Predicted operation %d rejected: %s"), Pending.Request.PredictionKey, *Reason);
+			LocallyRejectedPredictionKeys.Add(Pending.Request.PredictionKey);
+			OnPredictionRejected.Broadcast(Pending.Request.PredictionKey, Reason);
+		}
+	}
+	RebuildPredictedSlots();
+
+	TArray<FInventorySlotHandle> ChangedSlots;
+	ChangedSlots.Reserve(Restored.Num());
+	for (const TPair<int32, int32>& Key : Restored)
+	{
+		ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(Key.Key, Key.Value));
+	}
+	OnSlotsChanged.Broadcast(ChangedSlots);
 }
 
-void UInventoryComponent::BeginPlay()
+void UInventoryComponent::RebuildPredictedSlots()
 {
-	Super::BeginPlay();
-
-	for (FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroups())
+	PredictedSlots.Reset();
+	for (const FPendingPrediction& Pending : PendingPredictions)
 	{
-		if (Group.GetSlots().Num() == 0 && Group.GetMaxSlotSize() > 0)
+		for (const TPair<int32, int32>& Touched : Pending.TouchedSlots)
 		{
-			Group.InitializeInventory(Group.GetMaxSlotSize(), Group.GetTypeIDMap());
+			++PredictedSlots.FindOrAdd(Touched);
 		}
 	}
-
-	InventorySlotsGroup.RebuildCache();
 }
 
 void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType,
@@ -98,15 +955,16 @@ FInventoryOperationResult UInventoryComponent::AddItem(UItemBase* Item, int32 Ta
 		return FailResult;
 	}
 
-	FInventoryOperationResult Result = InventorySlotsGroup.AddItem(Item, TargetTypeID);
+	int32 FoundTypeID = -1;
+	int32 SlotIdx = INDEX_NONE;
+	FInventoryOperationResult Result = InventorySlotsGroup.AddItem(Item, TargetTypeID, &FoundTypeID, &SlotIdx);
 
 	if (Result.bSuccess)
 	{
-		int32 FoundTypeID, SlotIdx;
-		if (FindItemLocation(Item, FoundTypeID, SlotIdx))
+		if (SlotIdx != INDEX_NONE)
 		{
 			Item->OnAddedToInventory(GetOwner());
-			OnItemAdded.Broadcast(Item, FoundTypeID, SlotIdx);
+			BroadcastItemAdded(Item, FoundTypeID, SlotIdx, InventorySlotsGroup.MakeSlotHandleByTypeID(FoundTypeID, SlotIdx));
 		}
 		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, Result,
 			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
@@ -114,115 +972,486 @@ FInventoryOperationResult UInventoryComponent::AddItem(UItemBase* Item, int32 Ta
 		return Result;
 	}
 
-	UE_LOG(LogInventory, Warning, TEXT("AddItem failed: %s"), *Result.Message);
-	OnInventoryFull.Broadcast(Item, 1);
-	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, Result,
+	UE_LOG(LogInventory, Warning, TEXT("AddItem failed: %s"), *Result.Message);
+	OnInventoryFull.Broadcast(Item, 1);
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Failed: %s"), *Result.Message));
+	return Result;
+}
+
+TArray<FInventoryBatchAddEntry> UInventoryComponent::AddItems(const TArray<UItemBase*>& Items, int32 TargetTypeID)
+{
+	return AddItems(MakeArrayView(Items), TargetTypeID);
+}
+
+TArray<FInventoryBatchAddEntry> UInventoryComponent::AddItems(TArrayView<UItemBase* const> Items, int32 TargetTypeID)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	TArray<FInventoryBatchAddEntry> Entries;
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("AddItems: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		Entries.Reserve(Items.Num());
+		for (UItemBase* Item : Items)
+		{
+			FInventoryBatchAddEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Item = Item;
+			Entry.Result = FailResult;
+			Entry.OverflowQuantity = IsValid(Item) ? Item->GetCurrentStackSize() : 0;
+		}
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return Entries;
+	}
+
+	const int32 CompletedCount = InventorySlotsGroup.AddItems(Items, TargetTypeID, Entries);
+
+	UItemBase* FirstOverflowItem = nullptr;
+	int32 OverflowCount = 0;
+	bool bAnyAdded = false;
+	for (const FInventoryBatchAddEntry& Entry : Entries)
+	{
+		bAnyAdded |= Entry.AddedQuantity > 0;
+
+		if (Entry.WasPlaced())
+		{
+			Entry.Item->OnAddedToInventory(GetOwner());
+		}
+
+		if (!Entry.Result.bSuccess && IsValid(Entry.Item))
+		{
+			FirstOverflowItem = FirstOverflowItem ? FirstOverflowItem : Entry.Item.Get();
+			++OverflowCount;
+		}
+	}
+
+	if (bAnyAdded)
+	{
+		OnItemsAdded.Broadcast(Entries);
+	}
+
+	if (FirstOverflowItem)
+	{
+		UE_LOG(LogInventory, Warning, TEXT("AddItems: %d of %d items did not fully fit"), OverflowCount, Entries.Num());
+		OnInventoryFull.Broadcast(FirstOverflowItem, OverflowCount);
+	}
+
+	FInventoryOperationResult Result = CompletedCount == Entries.Num()
+		? FInventoryOperationResult::Ok()
+		: FInventoryOperationResult::Fail(FString::Printf(TEXT("%d of %d items did not fully fit"),
+			Entries.Num() - CompletedCount, Entries.Num()));
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Batch: %d items"), Entries.Num()));
+	return Entries;
+}
+
+FInventoryOperationResult UInventoryComponent::RemoveItemAt(int32 TypeID, int32 SlotIndex, int32 Quantity)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("RemoveItemAt: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	if (Quantity <= 0)
+	{
+		UE_LOG(LogInventory, Error, TEXT("RemoveItemAt: Invalid quantity %d"), Quantity);
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Invalid quantity"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("Invalid quantity"));
+		return FailResult;
+	}
+
+	FInventorySlots* TargetGroup = InventorySlotsGroup.GetGroupByID(TypeID);
+	if (!TargetGroup)
+	{
+		UE_LOG(LogInventory, Error, TEXT("RemoveItemAt: Target group with TypeID %d not found"), TypeID);
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Target group with TypeID %d not found"), TypeID));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+			FString::Printf(TEXT("Group %d not found"), TypeID));
+		return FailResult;
+	}
+
+	const FInventorySlot* Slot = TargetGroup->GetSlotAtIndex(SlotIndex);
+	if (!Slot || Slot->IsEmpty())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("RemoveItemAt: Slot %d in group %d is empty or invalid"), SlotIndex, TypeID);
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Slot %d in group %d is empty or invalid"), SlotIndex, TypeID));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+			FString::Printf(TEXT("Slot %d empty"), SlotIndex));
+		return FailResult;
+	}
+
+	// Null for value stacks, which have no object to release
+	UItemBase* ItemRef = Slot->GetItem();
+	const FInventorySlotHandle Handle = InventorySlotsGroup.MakeSlotHandleByTypeID(TypeID, SlotIndex);
+
+	FInventoryOperationResult RemoveResult = TargetGroup->RemoveStackAmountFromSlot(SlotIndex, Quantity);
+	if (RemoveResult.bSuccess)
+	{
+		if (ItemRef && Slot->IsEmpty())
+		{
+			ItemRef->OnRemovedFromInventory();
+
+			if (UWorld* World = GetWorld())
+			{
+				if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
+				{
+					PoolSubsystem->ReturnItemToPool(ItemRef);
+				}
+			}
+		}
+
+		if (ItemRef)
+		{
+			BroadcastItemRemoved(ItemRef, TypeID, SlotIndex, Handle);
+		}
+		else
+		{
+			TArray<FInventorySlotHandle> ChangedSlots;
+			ChangedSlots.Add(Handle);
+			OnSlotsChanged.Broadcast(ChangedSlots);
+		}
+		FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, OkResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+			FString::Printf(TEXT("Group:%d Slot:%d Qty:%d"), TypeID, SlotIndex, Quantity));
+		return OkResult;
+	}
+
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, RemoveResult,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Failed: %s"), *RemoveResult.Message));
+	return RemoveResult;
+}
+
+FInventoryOperationResult UInventoryComponent::TransferItem(int32 FromTypeID, int32 FromIndex, int32 ToTypeID, int32 ToIndex)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (CanPredict())
+	{
+		FInventoryPredictedRequest Request;
+		Request.Operation = EInventoryPredictedOperation::IPO_TransferItem;
+		Request.FromTypeID = FromTypeID;
+		Request.FromIndex = FromIndex;
+		Request.ToTypeID = ToTypeID;
+		Request.ToIndex = ToIndex;
+		return PredictOperation(Request);
+	}
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("TransferItem: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferItem, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	FInventoryOperationResult Result = InventorySlotsGroup.TransferItem(FromTypeID, FromIndex, ToTypeID, ToIndex);
+
+	if (!Result.bSuccess)
+	{
+		UE_LOG(LogInventory, Warning, TEXT("TransferItem failed: %s (From Group %d Index %d to Group %d Index %d)"),
+		       *Result.Message, FromTypeID, FromIndex, ToTypeID, ToIndex);
+	}
+
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferItem, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("From:%d,%d To:%d,%d"), FromTypeID, FromIndex, ToTypeID, ToIndex));
+	return Result;
+}
+
+FInventoryOperationResult UInventoryComponent::SwapSlots(int32 TypeID, int32 IndexA, int32 IndexB)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (CanPredict())
+	{
+		FInventoryPredictedRequest Request;
+		Request.Operation = EInventoryPredictedOperation::IPO_SwapSlots;
+		Request.FromTypeID = TypeID;
+		Request.FromIndex = IndexA;
+		Request.ToIndex = IndexB;
+		return PredictOperation(Request);
+	}
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("SwapSlots: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_SwapSlots, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	const int32 GroupIdx = InventorySlotsGroup.GetGroupIndexByID(TypeID);
+	FInventorySlots* Group = InventorySlotsGroup.GetGroupByIndex(GroupIdx);
+	FInventoryOperationResult Result = Group
+		? Group->SwapSlots(IndexA, IndexB)
+		: FInventoryOperationResult::Fail(FString::Printf(TEXT("Group with TypeID %d not found"), TypeID));
+
+	if (Result.bSuccess)
+	{
+		TArray<FInventorySlotHandle> ChangedSlots;
+		ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(GroupIdx, IndexA));
+		ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(GroupIdx, IndexB));
+		OnSlotsChanged.Broadcast(ChangedSlots);
+	}
+	else
+	{
+		UE_LOG(LogInventory, Warning, TEXT("SwapSlots failed: %s (Group %d, %d<->%d)"), *Result.Message, TypeID, IndexA, IndexB);
+	}
+
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_SwapSlots, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Group:%d %d<->%d"), TypeID, IndexA, IndexB));
+	return Result;
+}
+
+FInventoryOperationResult UInventoryComponent::SplitStack(int32 TypeID, int32 SourceIndex, int32 TargetIndex, int32 Amount)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (CanPredict())
+	{
+		FInventoryPredictedRequest Request;
+		Request.Operation = EInventoryPredictedOperation::IPO_SplitStack;
+		Request.FromTypeID = TypeID;
+		Request.FromIndex = SourceIndex;
+		Request.ToIndex = TargetIndex;
+		Request.Quantity = Amount;
+		return PredictOperation(Request);
+	}
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("SplitStack: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_SplitStack, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	const int32 GroupIdx = InventorySlotsGroup.GetGroupIndexByID(TypeID);
+	FInventorySlots* Group = InventorySlotsGroup.GetGroupByIndex(GroupIdx);
+	FInventoryOperationResult Result = Group
+		? Group->SplitStack(SourceIndex, TargetIndex, Amount)
+		: FInventoryOperationResult::Fail(FString::Printf(TEXT("Group with TypeID %d not found"), TypeID));
+
+	if (Result.bSuccess)
+	{
+		// UItemBase::SplitStack roots the new object in the transient package; from here the slot owns it
+		if (UItemBase* NewItem = Group->GetSlotAtIndex(TargetIndex)->GetItem())
+		{
+			NewItem->Rename(nullptr, this);
+			NewItem->RemoveFromRoot();
+			NewItem->OnAddedToInventory(GetOwner());
+		}
+
+		TArray<FInventorySlotHandle> ChangedSlots;
+		ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(GroupIdx, SourceIndex));
+		ChangedSlots.Add(InventorySlotsGroup.MakeSlotHandle(GroupIdx, TargetIndex));
+		OnSlotsChanged.Broadcast(ChangedSlots);
+	}
+	else
+	{
+		UE_LOG(LogInventory, Warning, TEXT("SplitStack failed: %s (Group %d, %d->%d x%d)"), *Result.Message, TypeID,
+		       SourceIndex, TargetIndex, Amount);
+	}
+
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_SplitStack, Result,
 		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-		FString::Printf(TEXT("Failed: %s"), *Result.Message));
+		FString::Printf(TEXT("Group:%d %d->%d x%d"), TypeID, SourceIndex, TargetIndex, Amount));
 	return Result;
 }
 
-FInventoryOperationResult UInventoryComponent::RemoveItemAt(int32 TypeID, int32 SlotIndex, int32 Quantity)
+FInventoryOperationResult UInventoryComponent::TransferToInventory(UInventoryComponent* Target,
+                                                                   const FInventorySlotHandle& Handle,
+                                                                   int32 Quantity, int32 TargetTypeID)
 {
 	double StartTime = FPlatformTime::Seconds();
 
-	if (!GetOwner() || !GetOwner()->HasAuthority())
+	auto FailWith = [this, StartTime](const FString& Reason, const TCHAR* Context)
 	{
-		UE_LOG(LogInventory, Warning, TEXT("RemoveItemAt: No authority or no owner"));
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		UE_LOG(LogInventory, Warning, TEXT("TransferToInventory: %s"), *Reason);
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(Reason);
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferToInventory, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), Context);
 		return FailResult;
+	};
+
+	if (!GetOwner() || !GetOwner()->HasAuthority() || !IsValid(Target) || !Target->GetOwner()
+		|| !Target->GetOwner()->HasAuthority())
+	{
+		return FailWith(TEXT("No authority or no owner"), TEXT("No authority"));
 	}
 
-	if (Quantity <= 0)
+	if (Target == this)
 	{
-		UE_LOG(LogInventory, Error, TEXT("RemoveItemAt: Invalid quantity %d"), Quantity);
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Invalid quantity"));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("Invalid quantity"));
-		return FailResult;
+		return FailWith(TEXT("Target is the source inventory; use TransferItem"), TEXT("Same inventory"));
 	}
 
-	FInventorySlots* TargetGroup = InventorySlotsGroup.GetGroupByID(TypeID);
-	if (!TargetGroup)
+	const FInventorySlot* SourceSlot = InventorySlotsGroup.ResolveHandle(Handle);
+	if (!SourceSlot || SourceSlot->IsEmpty())
 	{
-		UE_LOG(LogInventory, Error, TEXT("RemoveItemAt: Target group with TypeID %d not found"), TypeID);
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Target group with TypeID %d not found"), TypeID));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-			FString::Printf(TEXT("Group %d not found"), TypeID));
-		return FailResult;
+		return FailWith(TEXT("Source handle is stale or the slot is empty"), TEXT("Stale handle"));
 	}
 
-	const FInventorySlot* Slot = TargetGroup->GetSlotAtIndex(SlotIndex);
-	if (!Slot || Slot->IsEmpty())
+	// Null for value stacks, which move as a class and a count
+	UItemBase* Item = SourceSlot->GetItem();
+	const TSubclassOf<UItemBase> ValueItemClass = SourceSlot->GetValueItemClass();
+	const int32 StackSize = SourceSlot->GetCurrentStackSize();
+	const int32 Amount = Quantity < 0 ? StackSize : Quantity;
+	if (Amount <= 0 || Amount > StackSize)
 	{
-		UE_LOG(LogInventory, Warning, TEXT("RemoveItemAt: Slot %d in group %d is empty or invalid"), SlotIndex, TypeID);
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Slot %d in group %d is empty or invalid"), SlotIndex, TypeID));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-			FString::Printf(TEXT("Slot %d empty"), SlotIndex));
-		return FailResult;
+		return FailWith(FString::Printf(TEXT("Cannot take %d from a stack of %d"), Amount, StackSize),
+		                TEXT("Bad quantity"));
 	}
 
-	UItemBase* ItemRef = Slot->GetItem();
+	const bool bWholeStack = Amount == StackSize;
 
-	FInventoryOperationResult RemoveResult = TargetGroup->RemoveStackAmountFromSlot(SlotIndex, Quantity);
-	if (RemoveResult.bSuccess)
+	FInventoryAddPlanOverlay Overlay;
+	const FInventoryAddPlan Plan = Target->GetInventorySlotsGroup().PlanAdd(SourceSlot->GetItemPrototype(), Amount,
+		TargetTypeID, Overlay);
+	if (!Plan.FitsCompletely())
+	{
+		return FailWith(FString::Printf(TEXT("Target has room for %d of %d units"), Plan.FitQuantity, Amount),
+		                TEXT("No room"));
+	}
+
+	// Only the item object itself can start a stack in the target; there is no split. Value stacks can start any number.
+	const FInventoryPlannedPlacement* NewStack = nullptr;
+	for (const FInventoryPlannedPlacement& Placement : Plan.Placements)
 	{
-		if (Slot->IsEmpty())
+		if (Placement.bNewStack)
 		{
-			ItemRef->OnRemovedFromInventory();
+			if (Item && (NewStack || !bWholeStack))
+			{
+				return FailWith(TEXT("Part of the stack would need a new slot in the target"), TEXT("Needs split"));
+			}
+			NewStack = &Placement;
+		}
+	}
 
-			if (UWorld* World = GetWorld())
+	// Validation passed; write the target first so the source slot is only cleared once the units have landed
+	FInventorySlotsGroup& TargetSlotsGroup = Target->GetInventorySlotsGroup();
+	TArray<FInventorySlotHandle> TargetChanged;
+	TArray<int32, TInlineAllocator<4>> TargetOldAmounts;
+	for (const FInventoryPlannedPlacement& Placement : Plan.Placements)
+	{
+		const int32 GroupIdx = TargetSlotsGroup.GetGroupIndexByID(Placement.TypeID);
+		FInventorySlots* Group = TargetSlotsGroup.GetGroupByIndex(GroupIdx);
+		TargetOldAmounts.Add(Group->GetSlotAtIndex(Placement.SlotIndex)->GetCurrentStackSize());
+		if (Placement.bNewStack && !Item)
+		{
+			Group->SetValueStackContents(Placement.SlotIndex, ValueItemClass, Placement.Quantity);
+		}
+		else if (Placement.bNewStack)
+		{
+			if (Item->GetOuter() != Target)
 			{
-				if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
-				{
-					PoolSubsystem->ReturnItemToPool(ItemRef);
-				}
+				Item->Rename(nullptr, Target);
 			}
+			Group->SetSlotContents(Placement.SlotIndex, Item, Placement.Quantity);
 		}
+		else
+		{
+			Group->AddToSlotStack(Placement.SlotIndex, Placement.Quantity);
+		}
+		TargetChanged.Add(TargetSlotsGroup.MakeSlotHandle(GroupIdx, Placement.SlotIndex));
+	}
 
-		OnItemRemoved.Broadcast(ItemRef, TypeID, SlotIndex);
-		FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, OkResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-			FString::Printf(TEXT("Group:%d Slot:%d Qty:%d"), TypeID, SlotIndex, Quantity));
-		return OkResult;
+	FInventorySlots& SourceGroup = InventorySlotsGroup.GetInventoryGroupsMutable()[Handle.GroupIndex];
+	if (Item)
+	{
+		SourceGroup.SetSlotContents(Handle.SlotIndex, bWholeStack ? nullptr : Item, StackSize - Amount);
+	}
+	else
+	{
+		SourceGroup.SetValueStackContents(Handle.SlotIndex, ValueItemClass, StackSize - Amount);
 	}
+	TArray<FInventorySlotHandle> SourceChanged;
+	SourceChanged.Add(InventorySlotsGroup.MakeSlotHandle(Handle.GroupIndex, Handle.SlotIndex));
 
-	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_RemoveItemAt, RemoveResult,
-		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-		FString::Printf(TEXT("Failed: %s"), *RemoveResult.Message));
-	return RemoveResult;
-}
+	if (Item && bWholeStack)
+	{
+		Item->OnRemovedFromInventory();
 
-FInventoryOperationResult UInventoryComponent::TransferItem(int32 FromTypeID, int32 FromIndex, int32 ToTypeID, int32 ToIndex)
-{
-	double StartTime = FPlatformTime::Seconds();
+		if (NewStack)
+		{
+			Item->OnAddedToInventory(Target->GetOwner());
+		}
+	}
 
-	if (!GetOwner() || !GetOwner()->HasAuthority())
+	// The per-item events keep modules and legacy listeners in step; value stacks have no object to report
+	if (Item)
 	{
-		UE_LOG(LogInventory, Warning, TEXT("TransferItem: No authority or no owner"));
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferItem, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
-		return FailResult;
+		const int32 SourceTypeID = InventorySlotsGroup.GetTypeIDForGroupIndex(Handle.GroupIndex);
+		if (bWholeStack)
+		{
+			BroadcastItemRemoved(Item, SourceTypeID, Handle.SlotIndex, Handle);
+		}
+		else
+		{
+			BroadcastItemStackChanged(Item, SourceTypeID, Handle.SlotIndex, StackSize, StackSize - Amount, SourceChanged[0]);
+		}
 	}
 
-	FInventoryOperationResult Result = InventorySlotsGroup.TransferItem(FromTypeID, FromIndex, ToTypeID, ToIndex);
+	for (int32 i = 0; i < Plan.Placements.Num(); ++i)
+	{
+		const FInventoryPlannedPlacement& Placement = Plan.Placements[i];
+		const FInventorySlot* TargetSlot = TargetSlotsGroup.ResolveHandle(TargetChanged[i]);
+		UItemBase* TargetItem = TargetSlot ? TargetSlot->GetItem() : nullptr;
+		if (!TargetItem)
+		{
+			continue;
+		}
 
-	if (!Result.bSuccess)
+		if (Placement.bNewStack)
+		{
+			Target->BroadcastItemAdded(TargetItem, Placement.TypeID, Placement.SlotIndex, TargetChanged[i]);
+		}
+		else
+		{
+			Target->BroadcastItemStackChanged(TargetItem, Placement.TypeID, Placement.SlotIndex, TargetOldAmounts[i],
+			                                  TargetSlot->GetCurrentStackSize(), TargetChanged[i]);
+		}
+	}
+
+	OnItemTransferred.Broadcast(Item, this, Target, Amount, SourceChanged);
+	Target->OnItemTransferred.Broadcast(Item, this, Target, Amount, TargetChanged);
+
+	// Every unit merged into existing stacks, so this object is spent, as in TryStackItem
+	if (Item && bWholeStack && !NewStack)
 	{
-		UE_LOG(LogInventory, Warning, TEXT("TransferItem failed: %s (From Group %d Index %d to Group %d Index %d)"),
-		       *Result.Message, FromTypeID, FromIndex, ToTypeID, ToIndex);
+		if (UWorld* World = GetWorld())
+		{
+			if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
+			{
+				PoolSubsystem->ReturnItemToPool(Item);
+			}
+		}
 	}
 
-	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferItem, Result,
+	FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_TransferToInventory, OkResult,
 		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-		FString::Printf(TEXT("From:%d,%d To:%d,%d"), FromTypeID, FromIndex, ToTypeID, ToIndex));
-	return Result;
+		FString::Printf(TEXT("Qty:%d Slots:%d"), Amount, TargetChanged.Num()));
+	return OkResult;
 }
 
 bool UInventoryComponent::FindItemLocation(UItemBase* Item, int32& OutTypeID, int32& OutSlotIndex) const
@@ -230,6 +1459,39 @@ bool UInventoryComponent::FindItemLocation(UItemBase* Item, int32& OutTypeID, in
 	return InventorySlotsGroup.FindItemLocation(Item, OutTypeID, OutSlotIndex);
 }
 
+FInventorySlotHandle UInventoryComponent::FindItemHandle(UItemBase* Item) const
+{
+	return InventorySlotsGroup.FindItemHandle(Item);
+}
+
+FInventorySlotHandle UInventoryComponent::MakeSlotHandle(int32 TypeID, int32 SlotIndex) const
+{
+	return InventorySlotsGroup.MakeSlotHandleByTypeID(TypeID, SlotIndex);
+}
+
+bool UInventoryComponent::IsSlotHandleValid(const FInventorySlotHandle& Handle) const
+{
+	return InventorySlotsGroup.IsHandleValid(Handle);
+}
+
+UItemBase* UInventoryComponent::GetItemByHandle(const FInventorySlotHandle& Handle) const
+{
+	const FInventorySlot* Slot = InventorySlotsGroup.ResolveHandle(Handle);
+	return Slot ? Slot->GetItem() : nullptr;
+}
+
+bool UInventoryComponent::ResolveSlotHandle(const FInventorySlotHandle& Handle, int32& OutTypeID, int32& OutSlotIndex) const
+{
+	if (!InventorySlotsGroup.IsHandleValid(Handle))
+	{
+		return false;
+	}
+
+	OutTypeID = InventorySlotsGroup.GetTypeIDForGroupIndex(Handle.GroupIndex);
+	OutSlotIndex = Handle.SlotIndex;
+	return true;
+}
+
 void UInventoryComponent::OrganizeInventory()
 {
 	if (!GetOwner() || !GetOwner()->HasAuthority())
@@ -262,16 +1524,9 @@ bool UInventoryComponent::CanAddItem(UItemBase* Item, int32 SlotTypeID) const
 				continue;
 			}
 
-			for (const FInventorySlot& Slot : Group.GetSlots())
+			if (Group.HasPartialStack(Item->GetItemDefinition().GetItemKey()))
 			{
-				if (!Slot.IsEmpty() && 
-					Slot.GetItem()->GetItemDefinition().GetItemID() == Item->GetItemDefinition().GetItemID())
-				{
-					if (!Slot.IsFull())
-					{
-						return true;
-					}
-				}
+				return true;
 			}
 		}
 	}
@@ -279,6 +1534,46 @@ bool UInventoryComponent::CanAddItem(UItemBase* Item, int32 SlotTypeID) const
 	return GetEmptySlotCount(SlotTypeID) > 0;
 }
 
+FInventoryAddPlan UInventoryComponent::PlanAdd(UItemBase* Item, int32 Quantity, int32 TargetTypeID) const
+{
+	if (!IsValid(Item))
+	{
+		return FInventoryAddPlan();
+	}
+
+	FInventoryAddPlanOverlay Overlay;
+	return InventorySlotsGroup.PlanAdd(Item, Quantity < 0 ? Item->GetCurrentStackSize() : Quantity, TargetTypeID, Overlay);
+}
+
+FInventoryAddPlan UInventoryComponent::PlanAddByClass(TSubclassOf<UItemBase> ItemClass, int32 Quantity, int32 TargetTypeID) const
+{
+	if (!ItemClass)
+	{
+		return FInventoryAddPlan();
+	}
+
+	FInventoryAddPlanOverlay Overlay;
+	return InventorySlotsGroup.PlanAdd(ItemClass->GetDefaultObject<UItemBase>(), Quantity, TargetTypeID, Overlay);
+}
+
+bool UInventoryComponent::PlanAddBatch(const TArray<UItemBase*>& Items, TArray<FInventoryAddPlan>& OutPlans,
+                                       int32 TargetTypeID) const
+{
+	OutPlans.Reset(Items.Num());
+
+	FInventoryAddPlanOverlay Overlay;
+	bool bAllFit = true;
+	for (UItemBase* Item : Items)
+	{
+		const FInventoryAddPlan& Plan = OutPlans.Add_GetRef(IsValid(Item)
+			? InventorySlotsGroup.PlanAdd(Item, Item->GetCurrentStackSize(), TargetTypeID, Overlay)
+			: FInventoryAddPlan());
+		bAllFit &= Plan.FitsCompletely();
+	}
+
+	return bAllFit;
+}
+
 int32 UInventoryComponent::GetEmptySlotCount(int32 SlotTypeID) const
 {
 	int32 TotalEmpty = 0;
@@ -312,7 +1607,7 @@ FInventoryOperationResult UInventoryComponent::TryStackItem(UItemBase* Item, int
 
 	for (int32 GroupIdx = 0; GroupIdx < Groups.Num(); ++GroupIdx)
 	{
-		FInventorySlots& Group = InventorySlotsGroup.GetInventoryGroups()[GroupIdx];
+		FInventorySlots& Group = InventorySlotsGroup.GetInventoryGroupsMutable()[GroupIdx];
 
 		if (!Group.IsTypeSupported(Item))
 		{
@@ -324,48 +1619,43 @@ FInventoryOperationResult UInventoryComponent::TryStackItem(UItemBase* Item, int
 			continue;
 		}
 
-		TArray<FInventorySlot>& Slots = Group.GetSlotsMutable();
-
-		for (int32 j = 0; j < Slots.Num(); ++j)
+		for (int32 j : Group.GetPartialStackSlots(Item->GetItemDefinition().GetItemKey()))
 		{
-			FInventorySlot& Slot = Slots[j];
+			const FInventorySlot& Slot = Group.GetSlots()[j];
 
-			if (!Slot.IsEmpty() &&
-				Slot.GetItem()->GetItemDefinition().GetItemID() == Item->GetItemDefinition().GetItemID())
-			{
-				int32 OldAmount = Slot.GetCurrentStackSize();
-				int32 Overflow = Slot.AddToStack(Item->GetCurrentStackSize());
+			int32 OldAmount = Slot.GetCurrentStackSize();
+			int32 Overflow = Group.AddToSlotStack(j, Item->GetCurrentStackSize());
 
-				int32 CurrentTypeID = InventorySlotsGroup.GetTypeIDForGroupIndex(GroupIdx);
+			int32 CurrentTypeID = InventorySlotsGroup.GetTypeIDForGroupIndex(GroupIdx);
 
-				OnItemStackChanged.Broadcast(Slot.GetItem(), CurrentTypeID, j, OldAmount, Slot.GetCurrentStackSize());
+			BroadcastItemStackChanged(Slot.GetItem(), CurrentTypeID, j, OldAmount, Slot.GetCurrentStackSize(),
+			                          InventorySlotsGroup.MakeSlotHandle(GroupIdx, j));
 
-				if (Overflow <= 0)
+			if (Overflow <= 0)
+			{
+				if (UWorld* World = GetWorld())
 				{
-					if (UWorld* World = GetWorld())
+					if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
 					{
-						if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
-						{
-							PoolSubsystem->ReturnItemToPool(Item);
-						}
-						else
-						{
-							Item->MarkAsGarbage();
-						}
+						PoolSubsystem->ReturnItemToPool(Item);
 					}
 					else
 					{
 						Item->MarkAsGarbage();
 					}
-					FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
-					TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_StackItem, OkResult,
-						static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-						FString::Printf(TEXT("Stacked %s"), *Item->GetClass()->GetName()));
-					return OkResult;
 				}
-
-				Item->SetCurrentStackSize(Overflow);
+				else
+				{
+					Item->MarkAsGarbage();
+				}
+				FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+				TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_StackItem, OkResult,
+					static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+					FString::Printf(TEXT("Stacked %s"), *Item->GetClass()->GetName()));
+				return OkResult;
 			}
+
+			Item->SetCurrentStackSize(Overflow);
 		}
 	}
 
@@ -382,24 +1672,24 @@ int32 UInventoryComponent::GetItemCount(UItemBase* Item, int32 SlotTypeID) const
 		return 0;
 	}
 
+	const uint64 ItemKey = Item->GetItemDefinition().GetItemKey();
+
+	if (SlotTypeID == -1)
+	{
+		return InventorySlotsGroup.GetGlobalTotalItemCount(ItemKey);
+	}
+
 	int32 Count = 0;
 	const TArray<FInventorySlots>& Groups = InventorySlotsGroup.GetInventoryGroups();
 	
 	for (const FInventorySlots& Group : Groups)
 	{
-		if (SlotTypeID != -1 && !Group.GetTypeIDMap().Contains(SlotTypeID))
+		if (!Group.GetTypeIDMap().Contains(SlotTypeID))
 		{
 			continue;
 		}
 		
-		for (const FInventorySlot& Slot : Group.GetSlots())
-		{
-			if (!Slot.IsEmpty() && 
-				Slot.GetItem()->GetItemDefinition().GetItemID() == Item->GetItemDefinition().GetItemID())
-			{
-				Count += Slot.GetCurrentStackSize();
-			}
-		}
+		Count += Group.GetTotalItemCount(ItemKey);
 	}
 	
 	return Count;
@@ -452,6 +1742,40 @@ UItemBase* UInventoryComponent::GetItemAtIndex(int32 GroupIndex, int32 SlotIndex
 	return Slots->GetSlots()[SlotIndex].GetItem();
 }
 
+TSubclassOf<UItemBase> UInventoryComponent::GetItemClassAtIndex(int32 SlotTypeID, int32 SlotIndex) const
+{
+	const FInventorySlots* Slots = InventorySlotsGroup.GetItemsByTypeID(SlotTypeID);
+	const FInventorySlot* Slot = Slots ? Slots->GetSlotAtIndex(SlotIndex) : nullptr;
+	return Slot && !Slot->IsEmpty() ? Slot->GetItemClass() : nullptr;
+}
+
+UItemBase* UInventoryComponent::MaterializeSlot(int32 GroupIndex, int32 SlotIndex)
+{
+	FInventorySlots* Group = InventorySlotsGroup.GetGroupByIndex(GroupIndex);
+	const FInventorySlot* Slot = Group ? Group->GetSlotAtIndex(SlotIndex) : nullptr;
+	if (!Slot || !Slot->IsValueStack())
+	{
+		return Slot ? Slot->GetItem() : nullptr;
+	}
+
+	// Clients get the object through replication once the server materializes it
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		return nullptr;
+	}
+
+	UItemBase* Item = CreateItemInstance(Slot->GetValueItemClass());
+	if (!IsValid(Item))
+	{
+		return nullptr;
+	}
+
+	Item->SetCurrentStackSize(Slot->GetCurrentStackSize());
+	Group->MaterializeSlot(SlotIndex, Item);
+	Item->OnAddedToInventory(GetOwner());
+	return Item;
+}
+
 void UInventoryComponent::SortInventory()
 {
 	OrganizeInventory();
@@ -464,8 +1788,7 @@ void UInventoryComponent::ClearInventory()
 		return;
 	}
 
-	TArray<FInventorySlots>& Groups = InventorySlotsGroup.GetInventoryGroups();
-	for (FInventorySlots& Group : Groups)
+	for (FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroupsMutable())
 	{
 		for (const FInventorySlot& Slot : Group.GetSlots())
 		{
@@ -494,13 +1817,13 @@ TArray<UItemBase*> UInventoryComponent::GetAllItems() const
 	
 	for (const FInventorySlots& Group : InventorySlotsGroup.GetInventoryGroups())
 	{
-		for (const FInventorySlot& Slot : Group.GetSlots())
+		Group.ForEachOccupiedSlot([&Items](int32, const FInventorySlot& Slot)
 		{
-			if (!Slot.IsEmpty())
+			if (UItemBase* Item = Slot.GetItem())
 			{
-				Items.Add(Slot.GetItem());
+				Items.Add(Item);
 			}
-		}
+		});
 	}
 	
 	return Items;
@@ -519,6 +1842,37 @@ FInventoryOperationResult UInventoryComponent::AddItemByClass(TSubclassOf<UItemB
 		return FailResult;
 	}
 
+	// Module-less stackables are stored as a class and a count; no object is created until something asks for one
+	if (ItemClass->GetDefaultObject<UItemBase>()->SupportsValueStacks())
+	{
+		if (!GetOwner() || !GetOwner()->HasAuthority())
+		{
+			UE_LOG(LogInventory, Warning, TEXT("AddItemByClass: No authority or no owner"));
+			FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+			TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, FailResult,
+				static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+			return FailResult;
+		}
+
+		TArray<FInventorySlotHandle> ChangedSlots;
+		if (!InventorySlotsGroup.AddValueStacks(ItemClass, Quantity, SlotTypeID, ChangedSlots))
+		{
+			UE_LOG(LogInventory, Warning, TEXT("AddItemByClass: No room for %d of %s"), Quantity, *ItemClass->GetName());
+			FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("Not enough room for the value stack"));
+			OnInventoryFull.Broadcast(nullptr, 1);
+			TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, FailResult,
+				static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No room"));
+			return FailResult;
+		}
+
+		OnSlotsChanged.Broadcast(ChangedSlots);
+		FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_AddItem, OkResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+			FString::Printf(TEXT("Value stack: %s x%d"), *ItemClass->GetName(), Quantity));
+		return OkResult;
+	}
+
 	UItemBase* NewItem = CreateItemInstance(ItemClass);
 	if (!IsValid(NewItem))
 	{
@@ -555,6 +1909,73 @@ FInventoryOperationResult UInventoryComponent::AddItemByClass(TSubclassOf<UItemB
 	return Result;
 }
 
+FInventoryOperationResult UInventoryComponent::ConsumeItems(const FString& ItemID, int32 Quantity)
+{
+	const TPair<uint64, int32> Request(FItemDefinition::MakeItemKey(ItemID), Quantity);
+	return ConsumeItemKeys(MakeArrayView(&Request, 1));
+}
+
+FInventoryOperationResult UInventoryComponent::ConsumeItemSet(const TMap<FString, int32>& Ingredients)
+{
+	TArray<TPair<uint64, int32>, TInlineAllocator<8>> Requests;
+	Requests.Reserve(Ingredients.Num());
+	for (const TPair<FString, int32>& Ingredient : Ingredients)
+	{
+		Requests.Emplace(FItemDefinition::MakeItemKey(Ingredient.Key), Ingredient.Value);
+	}
+
+	return ConsumeItemKeys(Requests);
+}
+
+FInventoryOperationResult UInventoryComponent::ConsumeItemKeys(TArrayView<const TPair<uint64, int32>> Requests)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogInventory, Warning, TEXT("ConsumeItems: No authority or no owner"));
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_ConsumeItems, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+		return FailResult;
+	}
+
+	TArray<UItemBase*> EmptiedItems;
+	TArray<FInventorySlotHandle> ChangedSlots;
+	FInventoryOperationResult Result = InventorySlotsGroup.ConsumeItems(Requests, EmptiedItems, ChangedSlots);
+
+	if (!Result.bSuccess)
+	{
+		UE_LOG(LogInventory, Verbose, TEXT("ConsumeItems failed: %s"), *Result.Message);
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_ConsumeItems, Result,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+			FString::Printf(TEXT("Failed: %s"), *Result.Message));
+		return Result;
+	}
+
+	for (UItemBase* Item : EmptiedItems)
+	{
+		Item->OnRemovedFromInventory();
+	}
+
+	if (EmptiedItems.Num() > 0)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
+			{
+				PoolSubsystem->ReturnItemsToPool(EmptiedItems);
+			}
+		}
+	}
+
+	OnSlotsChanged.Broadcast(ChangedSlots);
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_ConsumeItems, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Items:%d Slots:%d"), Requests.Num(), ChangedSlots.Num()));
+	return Result;
+}
+
 UItemBase* UInventoryComponent::CreateItemInstance(TSubclassOf<UItemBase> ItemClass)
 {
 	if (!ItemClass)
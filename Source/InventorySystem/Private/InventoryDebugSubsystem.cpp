@@ -163,6 +163,27 @@ void UInventoryDebugSubsystem::DrawInventoryDebug(UInventoryComponent* Inventory
 			}
 		}
 	}
+
+	if (DebugMode >= EInventoryDebugMode::IDM_Network)
+	{
+		StatsText = FString::Printf(TEXT("Net %s: %d updates | Avg: %.1f B | Last: %d B | Peak: %d B"),
+		                            Inventory->GetOwnerRole() == ROLE_Authority ? TEXT("Sent") : TEXT("Received"),
+		                            Stats.NetUpdates, Stats.NetAverageBytesPerUpdate,
+		                            Stats.NetLastUpdateBytes, Stats.NetPeakUpdateBytes);
+		FCanvasTextItem TextNet(FVector2D(XPos, YPos), FText::FromString(StatsText), GEngine->GetMediumFont(),
+		                        FLinearColor(0.5f, 0.5f, 1.0f));
+		Canvas->DrawItem(TextNet);
+		YPos += LineHeight;
+
+		const FInventoryNetMetrics& Metrics = Inventory->GetNetMetrics();
+		StatsText = FString::Printf(TEXT("Net Work: %d props dirty | subobjects %d reg / %d written | %.3fms"),
+		                            Metrics.PropertiesMarkedDirty, Metrics.SubobjectsRegistered, Metrics.SubobjectsWritten,
+		                            Metrics.PreReplicationMs + Metrics.ReplicateSubobjectsMs);
+		FCanvasTextItem TextNetWork(FVector2D(XPos, YPos), FText::FromString(StatsText), GEngine->GetMediumFont(),
+		                            FLinearColor(0.5f, 0.5f, 1.0f));
+		Canvas->DrawItem(TextNetWork);
+		YPos += LineHeight;
+	}
 }
 
 FInventoryDebugStats UInventoryDebugSubsystem::GetInventoryStats(UInventoryComponent* Inventory)
@@ -175,8 +196,10 @@ FInventoryDebugStats UInventoryDebugSubsystem::GetInventoryStats(UInventoryCompo
 	}
 
 	TSet<FString> UniqueTypes;
+	TSet<UClass*> ItemClasses;
 	int32 TotalStackSize = 0;
 	int32 StackableCount = 0;
+	Stats.InstalledModuleCount = 0;
 
 	const TArray<FInventorySlots>& Groups = Inventory->GetInventorySlotsGroup().GetInventoryGroups();
 	Stats.TotalGroups = Groups.Num();
@@ -197,26 +220,30 @@ FInventoryDebugStats UInventoryDebugSubsystem::GetInventoryStats(UInventoryCompo
 		Stats.GroupBreakdowns.Add(FString::Printf(TEXT("Group %d [%s]: %d/%d slots"),
 		                                          GroupIdx, *TypeNames, GroupUsed, GroupTotal));
 
-		for (const FInventorySlot& Slot : Group.GetSlots())
+		Stats.UsedSlots += GroupUsed;
+		Stats.TotalItems += Group.GetTotalStackUnits();
+
+		Group.ForEachOccupiedSlot([&](int32, const FInventorySlot& Slot)
 		{
-			if (!Slot.IsEmpty())
+			const UItemBase* Item = Slot.GetItemPrototype();
+			if (Item)
 			{
-				Stats.UsedSlots++;
-				Stats.TotalItems += Slot.GetCurrentStackSize();
+				UniqueTypes.Add(Item->GetItemDefinition().GetItemID());
+				ItemClasses.Add(Slot.GetItemClass());
 
-				UItemBase* Item = Slot.GetItem();
-				if (Item)
+				// Value stacks are module-less by construction, so only item objects can carry modules
+				if (const UItemBase* ItemObject = Slot.GetItem())
 				{
-					UniqueTypes.Add(Item->GetItemDefinition().GetItemID());
+					Stats.InstalledModuleCount += ItemObject->GetAllModules().Num();
+				}
 
-					if (Item->IsStackable())
-					{
-						StackableCount++;
-						TotalStackSize += Slot.GetCurrentStackSize();
-					}
+				if (Item->IsStackable())
+				{
+					StackableCount++;
+					TotalStackSize += Slot.GetCurrentStackSize();
 				}
 			}
-		}
+		});
 	}
 
 	Stats.EmptySlots = Stats.TotalSlots - Stats.UsedSlots;
@@ -228,28 +255,18 @@ FInventoryDebugStats UInventoryDebugSubsystem::GetInventoryStats(UInventoryCompo
 	Stats.MemoryUsageBytes = Stats.TotalSlots * static_cast<int32>(sizeof(FInventorySlot))
 		+ Stats.UsedSlots * 512;
 
-	Stats.InstalledModuleCount = 0;
-	TArray<UItemBase*> AllItems = Inventory->GetAllItems();
-	for (UItemBase* Item : AllItems)
-	{
-		if (Item)
-		{
-			Stats.InstalledModuleCount += Item->GetAllModules().Num();
-		}
-	}
-
 	Stats.PooledItemsAvailable = 0;
 	Stats.PooledItemsActive = 0;
 	if (UWorld* World = Inventory->GetWorld())
 	{
 		if (UItemPoolSubsystem* PoolSys = World->GetSubsystem<UItemPoolSubsystem>())
 		{
-			for (UItemBase* Item : AllItems)
+			for (UClass* ItemClass : ItemClasses)
 			{
-				if (Item)
+				if (ItemClass)
 				{
 					int32 Available = 0, Active = 0, Total = 0;
-					PoolSys->GetPoolStats(Item->GetClass(), Available, Active, Total);
+					PoolSys->GetPoolStats(ItemClass, Available, Active, Total);
 					Stats.PooledItemsAvailable += Available;
 					Stats.PooledItemsActive += Active;
 				}
@@ -257,6 +274,12 @@ FInventoryDebugStats UInventoryDebugSubsystem::GetInventoryStats(UInventoryCompo
 		}
 	}
 
+	const FInventoryReplicationStats NetStats = Inventory->GetReplicationStats();
+	Stats.NetUpdates = NetStats.Updates;
+	Stats.NetAverageBytesPerUpdate = NetStats.GetAverageBytesPerUpdate();
+	Stats.NetLastUpdateBytes = FMath::DivideAndRoundUp(NetStats.LastUpdateBits, 8);
+	Stats.NetPeakUpdateBytes = FMath::DivideAndRoundUp(NetStats.PeakUpdateBits, 8);
+
 	return Stats;
 }
 
@@ -283,7 +306,7 @@ void UInventoryDebugSubsystem::LogInventoryContents(UInventoryComponent* Invento
 			const FInventorySlot& Slot = Group.GetSlots()[SlotIdx];
 			if (!Slot.IsEmpty())
 			{
-				UItemBase* Item = Slot.GetItem();
+				const UItemBase* Item = Slot.GetItemPrototype();
 				UE_LOG(LogInventory, Log, TEXT("  [%d] %s x%d"),
 				       SlotIdx,
 				       *Item->GetItemDefinition().GetItemName().ToString(),
@@ -426,6 +449,13 @@ void UInventoryDebugSubsystem::SetItemStack(int32 GroupIndex, int32 SlotIndex, i
 	}
 
 	UItemBase* Item = PlayerInv->GetItemAtIndex(GroupIndex, SlotIndex);
+	if (!Item)
+	{
+		// Editing a value stack needs an object, so this debug command materializes it explicitly
+		const FInventorySlotHandle Handle = PlayerInv->MakeSlotHandle(GroupIndex, SlotIndex);
+		Item = Handle.IsSet() ? PlayerInv->MaterializeSlot(Handle.GroupIndex, Handle.SlotIndex) : nullptr;
+	}
+
 	if (Item)
 	{
 		Item->SetCurrentStackSize(StackSize);
@@ -441,10 +471,11 @@ void UInventoryDebugSubsystem::DuplicateItem(int32 GroupIndex, int32 SlotIndex)
 		return;
 	}
 
-	UItemBase* Item = PlayerInv->GetItemAtIndex(GroupIndex, SlotIndex);
-	if (Item)
+	const FInventorySlots* Slots = PlayerInv->GetInventorySlotsGroup().GetItemsByTypeID(GroupIndex);
+	const FInventorySlot* Slot = Slots ? Slots->GetSlotAtIndex(SlotIndex) : nullptr;
+	if (Slot && !Slot->IsEmpty())
 	{
-		PlayerInv->AddItemByClass(Item->GetClass(), Item->GetCurrentStackSize());
+		PlayerInv->AddItemByClass(Slot->GetItemClass(), Slot->GetCurrentStackSize());
 		UE_LOG(LogInventory, Log, TEXT("Duplicated item"));
 	}
 }
@@ -555,19 +586,62 @@ float UInventoryDebugSubsystem::BenchmarkSearch(UInventoryComponent* Inventory,
 		return 0.0f;
 	}
 
-	UItemBase* SearchItem = AllItems[0];
+	// Last item is the worst case for a slot-by-slot scan
+	UItemBase* SearchItem = AllItems.Last();
+	const TArray<FInventorySlots>& Groups = Inventory->GetInventorySlotsGroup().GetInventoryGroups();
+
+	// Each loop sums the found slot indices and the sums are logged, so the optimizer cannot drop either search
+	int64 ScanChecksum = 0;
+	int64 IndexedChecksum = 0;
+
 	double StartTime = FPlatformTime::Seconds();
 
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		bool bFound = false;
+		for (const FInventorySlots& Group : Groups)
+		{
+			const TArray<FInventorySlot>& Slots = Group.GetSlots();
+			for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+			{
+				if (Slots[SlotIndex].GetItem() == SearchItem)
+				{
+					ScanChecksum += SlotIndex + 1;
+					bFound = true;
+					break;
+				}
+			}
+			if (bFound)
+			{
+				break;
+			}
+		}
+	}
+
+	double ScanElapsedTime = FPlatformTime::Seconds() - StartTime;
+	float ScanAvgTime = (ScanElapsedTime / Iterations) * 1000.0f;
+
+	StartTime = FPlatformTime::Seconds();
+
 	for (int32 i = 0; i < Iterations; ++i)
 	{
 		int32 TypeID, SlotIndex;
-		Inventory->FindItemLocation(SearchItem, TypeID, SlotIndex);
+		if (Inventory->FindItemLocation(SearchItem, TypeID, SlotIndex))
+		{
+			IndexedChecksum += SlotIndex + 1;
+		}
 	}
 
 	double ElapsedTime = FPlatformTime::Seconds() - StartTime;
 	float AvgTime = (ElapsedTime / Iterations) * 1000.0f;
 
-	UE_LOG(LogInventory, Log, TEXT("Search benchmark: %.3f ms avg (%d iterations)"), AvgTime, Iterations);
+	UE_LOG(LogInventory, Log, TEXT("Search benchmark: %.4f ms avg indexed, %.4f ms avg linear scan, %.1fx speedup (%d iterations)"),
+	       AvgTime, ScanAvgTime, AvgTime > 0.0f ? ScanAvgTime / AvgTime : 0.0f, Iterations);
+	if (ScanChecksum != IndexedChecksum)
+	{
+		UE_LOG(LogInventory, Warning, TEXT("Search benchmark: results differ (scan checksum %lld, indexed checksum %lld)"),
+		       ScanChecksum, IndexedChecksum);
+	}
 
 	return AvgTime;
 }
@@ -627,13 +701,24 @@ bool UInventoryDebugSubsystem::ValidateInventory(UInventoryComponent* Inventory,
 		for (int32 j = 0; j < Group.GetSlots().Num(); ++j)
 		{
 			const FInventorySlot& Slot = Group.GetSlots()[j];
-			if (!Slot.IsEmpty() && !IsValid(Slot.GetItem()))
+			if (!Slot.IsEmpty() && !IsValid(Slot.GetItemPrototype()))
 			{
 				OutErrors.Add(FString::Printf(TEXT("Group %d, Slot %d: Invalid item reference"), i, j));
 			}
 		}
+
+		TArray<FString> IndexErrors;
+		if (!Group.ValidateSlotIndex(IndexErrors))
+		{
+			for (const FString& Error : IndexErrors)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Group %d: %s"), i, *Error));
+			}
+		}
 	}
 
+	Inventory->GetInventorySlotsGroup().ValidateItemTotals(OutErrors);
+
 	return OutErrors.Num() == 0;
 }
 
@@ -658,8 +743,6 @@ void UInventoryDebugSubsystem::RunAutomatedTests(UInventoryComponent* Inventory)
 	UE_LOG(LogInventory, Log, TEXT("=== Running Automated Inventory Tests ==="));
 	UE_LOG(LogInventory, Log, TEXT("Test item class: %s"), *TestClass->GetName());
 
-	int32 InitialItemCount = Inventory->GetAllItems().Num();
-
 	{
 		UE_LOG(LogInventory, Log, TEXT("Test 1: AddItem"));
 		UItemBase* TestItem = NewObject<UItemBase>(Inventory, TestClass);
@@ -776,21 +859,20 @@ void UInventoryDebugSubsystem::RunAutomatedTests(UInventoryComponent* Inventory)
 				const FInventorySlots* Group = Inventory->GetInventorySlotsGroup().GetGroupByID(TypeID);
 				if (Group)
 				{
-					for (int32 i = 0; i < Group->GetSlots().Num(); ++i)
-					{
-						if (Group->GetSlots()[i].IsEmpty())
-						{
-							TargetSlot = i;
-							break;
-						}
-					}
+					TargetSlot = Group->FindFirstEmptySlot();
 				}
 
 				if (TargetSlot >= 0)
 				{
+					const FInventorySlotHandle SourceHandle = Inventory->MakeSlotHandle(TypeID, SlotIndex);
 					FInventoryOperationResult TransResult = Inventory->TransferItem(
 						TypeID, SlotIndex, TypeID, TargetSlot);
-					if (TransResult.bSuccess)
+					if (TransResult.bSuccess && Inventory->IsSlotHandleValid(SourceHandle))
+					{
+						UE_LOG(LogInventory, Error, TEXT("  FAIL - Handle to vacated slot %d is still valid"), SlotIndex);
+						Failed++;
+					}
+					else if (TransResult.bSuccess)
 					{
 						UE_LOG(LogInventory, Log, TEXT("  PASS - Transfer from slot %d to %d succeeded"), SlotIndex,
 						       TargetSlot);
@@ -982,6 +1064,15 @@ void UInventoryDebugSubsystem::TestNetworkReplication(UInventoryComponent* Inven
 		Issues += NonNetworkableModules;
 	}
 
+	const FInventoryReplicationStats NetStats = Inventory->GetReplicationStats();
+	const FInventoryNetMetrics& Metrics = Inventory->GetNetMetrics();
+	UE_LOG(LogInventory, Log, TEXT("  [INFO] Slot mirrors: %d updates, %lld bytes, avg %.1f B, peak %d B"),
+	       NetStats.Updates, (NetStats.TotalBits + 7) / 8, NetStats.GetAverageBytesPerUpdate(),
+	       FMath::DivideAndRoundUp(NetStats.PeakUpdateBits, 8));
+	UE_LOG(LogInventory, Log, TEXT("  [INFO] Net work: %d net updates, %d props dirty, subobjects %d registered / %d written, %.3fms"),
+	       Metrics.NetUpdates, Metrics.PropertiesMarkedDirty, Metrics.SubobjectsRegistered, Metrics.SubobjectsWritten,
+	       Metrics.PreReplicationMs + Metrics.ReplicateSubobjectsMs);
+
 	UE_LOG(LogInventory, Log, TEXT("=== Replication Validation Complete: %d issue(s) found ==="), Issues);
 }
 
@@ -1045,6 +1136,103 @@ TArray<FInventoryOperationRecord> UInventoryDebugSubsystem::GetFailedOperations(
 	return OperationTracker.GetFailedOperations(Count);
 }
 
+void UInventoryDebugSubsystem::RegisterInventory(UInventoryComponent* Inventory)
+{
+	if (Inventory)
+	{
+		TrackedInventories.AddUnique(Inventory);
+	}
+}
+
+void UInventoryDebugSubsystem::UnregisterInventory(UInventoryComponent* Inventory)
+{
+	TrackedInventories.Remove(Inventory);
+}
+
+TArray<FInventoryNetCostEntry> UInventoryDebugSubsystem::GetNetCostReport(int32 Count)
+{
+	TArray<FInventoryNetCostEntry> Report;
+	Report.Reserve(TrackedInventories.Num());
+
+	for (UInventoryComponent* Inventory : TrackedInventories)
+	{
+		if (!IsValid(Inventory))
+		{
+			continue;
+		}
+
+		const FInventoryReplicationStats NetStats = Inventory->GetReplicationStats();
+		const FInventoryNetMetrics& Metrics = Inventory->GetNetMetrics();
+
+		FInventoryNetCostEntry& Entry = Report.AddDefaulted_GetRef();
+		Entry.Inventory = Inventory;
+		Entry.Name = FString::Printf(TEXT("%s.%s"), *GetNameSafe(Inventory->GetOwner()), *Inventory->GetName());
+		Entry.TotalBytes = (NetStats.TotalBits + 7) / 8;
+		Entry.MirrorUpdates = NetStats.Updates;
+		Entry.AverageBytesPerUpdate = NetStats.GetAverageBytesPerUpdate();
+		Entry.NetUpdates = Metrics.NetUpdates;
+		Entry.PropertiesMarkedDirty = Metrics.PropertiesMarkedDirty;
+		Entry.SubobjectsRegistered = Metrics.SubobjectsRegistered;
+		Entry.SubobjectsWritten = Metrics.SubobjectsWritten;
+		Entry.ReplicationMs = static_cast<float>(Metrics.PreReplicationMs + Metrics.ReplicateSubobjectsMs);
+	}
+
+	Report.Sort([](const FInventoryNetCostEntry& A, const FInventoryNetCostEntry& B)
+	{
+		return A.TotalBytes != B.TotalBytes ? A.TotalBytes > B.TotalBytes : A.ReplicationMs > B.ReplicationMs;
+	});
+
+	if (Count > 0 && Report.Num() > Count)
+	{
+		Report.SetNum(Count);
+	}
+
+	return Report;
+}
+
+FString UInventoryDebugSubsystem::GetNetCostSummary(int32 Count)
+{
+	const TArray<FInventoryNetCostEntry> Report = GetNetCostReport(Count);
+
+	int64 TotalBytes = 0;
+	double TotalMs = 0.0;
+	for (UInventoryComponent* Inventory : TrackedInventories)
+	{
+		if (IsValid(Inventory))
+		{
+			const FInventoryNetMetrics& Metrics = Inventory->GetNetMetrics();
+			TotalBytes += (Inventory->GetReplicationStats().TotalBits + 7) / 8;
+			TotalMs += Metrics.PreReplicationMs + Metrics.ReplicateSubobjectsMs;
+		}
+	}
+
+	FString Summary = FString::Printf(TEXT("=== Inventory Net Cost: %d inventories, %lld bytes, %.3fms ===\n"),
+	                                  TrackedInventories.Num(), TotalBytes, TotalMs);
+
+	for (int32 i = 0; i < Report.Num(); ++i)
+	{
+		const FInventoryNetCostEntry& Entry = Report[i];
+		Summary += FString::Printf(
+			TEXT("%2d. %s: %lld B (%d updates, avg %.1f B) | %d net updates, %d props dirty | subobjects %d registered, %d written | %.3fms\n"),
+			i + 1, *Entry.Name, Entry.TotalBytes, Entry.MirrorUpdates, Entry.AverageBytesPerUpdate,
+			Entry.NetUpdates, Entry.PropertiesMarkedDirty, Entry.SubobjectsRegistered, Entry.SubobjectsWritten,
+			Entry.ReplicationMs);
+	}
+
+	return Summary;
+}
+
+void UInventoryDebugSubsystem::ResetNetCostStats()
+{
+	for (UInventoryComponent* Inventory : TrackedInventories)
+	{
+		if (IsValid(Inventory))
+		{
+			Inventory->ResetReplicationStats();
+		}
+	}
+}
+
 FString UInventoryDebugSubsystem::GetOperationSummary()
 {
 	return OperationTracker.GetSummaryString();
@@ -1,6 +1,7 @@
 #include "InventoryDragDropValidation.h"
 #include "InventorySystem.h"
 #include "InventoryComponent.h"
+#include "InventoryTransaction.h"
 
 TArray<FDragDropValidator> UInventoryDragDropValidation::CustomValidators;
 
@@ -16,6 +17,28 @@ FDragDropValidationResult UInventoryDragDropValidation::ValidateDragDrop(const F
 		return FDragDropValidationResult::Invalid(TEXT("Invalid source inventory"));
 	}
 
+	if (Context.SourceHandle.IsSet())
+	{
+		// A value stack has no object to compare against, so the handle's generation and the class stand in for it
+		int32 SourceTypeID = -1;
+		int32 SourceSlotIndex = INDEX_NONE;
+		const UItemBase* SourceItem = Context.SourceInventory->GetItemByHandle(Context.SourceHandle);
+		const bool bSourceCurrent = SourceItem
+			? SourceItem == Context.DraggedItem
+			: Context.SourceInventory->ResolveSlotHandle(Context.SourceHandle, SourceTypeID, SourceSlotIndex)
+				&& Context.SourceInventory->GetItemClassAtIndex(SourceTypeID, SourceSlotIndex) == Context.DraggedItem->GetClass();
+
+		if (!bSourceCurrent)
+		{
+			return FDragDropValidationResult::Invalid(TEXT("Source slot changed since the drag started"));
+		}
+	}
+
+	if (Context.TargetHandle.IsSet() && Context.TargetInventory && !Context.TargetInventory->IsSlotHandleValid(Context.TargetHandle))
+	{
+		return FDragDropValidationResult::Invalid(TEXT("Target slot changed since the drag started"));
+	}
+
 	FDragDropContext ModifiedContext = Context;
 	if (ModifiedContext.OperationType == EDragDropOperationType::DDOT_Move)
 	{
@@ -82,7 +105,7 @@ FDragDropValidationResult UInventoryDragDropValidation::ValidateSwap(const FDrag
 		return FDragDropValidationResult::Invalid(TEXT("Cannot swap with empty slot"));
 	}
 
-	UItemBase* TargetItem = TargetSlot->GetItem();
+	const UItemBase* TargetItem = TargetSlot->GetItemPrototype();
 	if (!TargetItem)
 	{
 		return FDragDropValidationResult::Invalid(TEXT("Invalid target item"));
@@ -104,7 +127,7 @@ FDragDropValidationResult UInventoryDragDropValidation::ValidateStack(const FDra
 		return FDragDropValidationResult::Invalid(TEXT("Cannot stack with empty slot"));
 	}
 
-	UItemBase* TargetItem = TargetSlot->GetItem();
+	const UItemBase* TargetItem = TargetSlot->GetItemPrototype();
 	if (!CanItemsStack(Context.DraggedItem, TargetItem))
 	{
 		return FDragDropValidationResult::Invalid(TEXT("Items cannot be stacked together"));
@@ -204,7 +227,7 @@ EDragDropOperationType UInventoryDragDropValidation::DetermineOperationType(cons
 		return EDragDropOperationType::DDOT_Move;
 	}
 
-	if (CanItemsStack(Context.DraggedItem, TargetSlot->GetItem()))
+	if (CanItemsStack(Context.DraggedItem, TargetSlot->GetItemPrototype()))
 	{
 		return EDragDropOperationType::DDOT_Stack;
 	}
@@ -222,22 +245,32 @@ bool UInventoryDragDropValidation::ExecuteDragDrop(const FDragDropContext& Conte
 		return false;
 	}
 
+	int32 SourceTypeID, SourceSlot;
+	if (!ResolveContextSlot(Context.SourceInventory, Context.SourceHandle, Context.SourceGroupIndex,
+	                        Context.SourceSlotIndex, SourceTypeID, SourceSlot))
+	{
+		UE_LOG(LogInventory, Warning, TEXT("ExecuteDragDrop: Source handle is stale"));
+		return false;
+	}
+
+	int32 TargetTypeID, TargetSlot;
+	if (!ResolveContextSlot(Context.TargetInventory, Context.TargetHandle, Context.TargetGroupIndex,
+	                        Context.TargetSlotIndex, TargetTypeID, TargetSlot))
+	{
+		UE_LOG(LogInventory, Warning, TEXT("ExecuteDragDrop: Target handle is stale"));
+		return false;
+	}
+
 	switch (ValidationResult.SuggestedOperation)
 	{
 	case EDragDropOperationType::DDOT_Move:
-		return Context.SourceInventory->TransferItem(
-			Context.SourceGroupIndex, Context.SourceSlotIndex,
-			Context.TargetGroupIndex, Context.TargetSlotIndex
-		).bSuccess;
+		return Context.SourceInventory->TransferItem(SourceTypeID, SourceSlot, TargetTypeID, TargetSlot).bSuccess;
 
 	case EDragDropOperationType::DDOT_Swap:
-		return Context.SourceInventory->TransferItem(
-			Context.SourceGroupIndex, Context.SourceSlotIndex,
-			Context.TargetGroupIndex, Context.TargetSlotIndex
-		).bSuccess;
+		return Context.SourceInventory->TransferItem(SourceTypeID, SourceSlot, TargetTypeID, TargetSlot).bSuccess;
 
 	case EDragDropOperationType::DDOT_Stack:
-		return Context.SourceInventory->TryStackItem(Context.DraggedItem, Context.TargetGroupIndex).bSuccess;
+		return Context.SourceInventory->TryStackItem(Context.DraggedItem, TargetTypeID).bSuccess;
 
 	case EDragDropOperationType::DDOT_Split:
 		UE_LOG(LogInventory, Warning, TEXT("Split operation not yet implemented"));
@@ -246,16 +279,24 @@ bool UInventoryDragDropValidation::ExecuteDragDrop(const FDragDropContext& Conte
 	case EDragDropOperationType::DDOT_Transfer:
 		if (Context.TargetInventory)
 		{
-			if (Context.SourceInventory->RemoveItem(Context.DraggedItem).bSuccess)
+			if (!Context.SourceHandle.IsSet()
+				&& !Context.SourceInventory->FindItemLocation(Context.DraggedItem, SourceTypeID, SourceSlot))
+			{
+				UE_LOG(LogInventory, Warning, TEXT("ExecuteDragDrop: Dragged item is not in the source inventory"));
+				return false;
+			}
+
+			FInventoryTransaction Transaction;
+			Transaction.StageMove(Context.SourceInventory, SourceTypeID, SourceSlot,
+			                      Context.TargetInventory, TargetTypeID, INDEX_NONE);
+
+			const FInventoryOperationResult Result = Transaction.Commit();
+			if (!Result.bSuccess)
 			{
-				if (!Context.TargetInventory->AddItem(Context.DraggedItem, Context.TargetGroupIndex).bSuccess)
-				{
-					Context.SourceInventory->AddItem(Context.DraggedItem);
-					UE_LOG(LogInventory, Warning, TEXT("ExecuteDragDrop: Transfer failed, item returned to source"));
-					return false;
-				}
-				return true;
+				UE_LOG(LogInventory, Warning, TEXT("ExecuteDragDrop: Transfer failed - %s"), *Result.Message);
+				return false;
 			}
+			return true;
 		}
 		return false;
 
@@ -279,13 +320,12 @@ void UInventoryDragDropValidation::ClearCustomValidators()
 
 bool UInventoryDragDropValidation::IsTargetSlotCompatible(const FDragDropContext& Context)
 {
-	if (!Context.TargetInventory || !Context.DraggedItem)
+	if (!Context.DraggedItem)
 	{
 		return false;
 	}
 
-	FInventorySlots* TargetGroup = Context.TargetInventory->GetInventorySlotsGroup().GetGroupByID(
-		Context.TargetGroupIndex);
+	const FInventorySlots* TargetGroup = GetTargetGroup(Context);
 	if (!TargetGroup)
 	{
 		return false;
@@ -294,7 +334,7 @@ bool UInventoryDragDropValidation::IsTargetSlotCompatible(const FDragDropContext
 	return TargetGroup->IsTypeSupported(Context.DraggedItem);
 }
 
-bool UInventoryDragDropValidation::CanItemsStack(UItemBase* ItemA, UItemBase* ItemB)
+bool UInventoryDragDropValidation::CanItemsStack(const UItemBase* ItemA, const UItemBase* ItemB)
 {
 	if (!ItemA || !ItemB)
 	{
@@ -306,7 +346,7 @@ bool UInventoryDragDropValidation::CanItemsStack(UItemBase* ItemA, UItemBase* It
 		return false;
 	}
 
-	return ItemA->GetItemDefinition().GetItemID() == ItemB->GetItemDefinition().GetItemID();
+	return ItemA->GetItemDefinition().GetItemKey() == ItemB->GetItemDefinition().GetItemKey();
 }
 
 const FInventorySlot* UInventoryDragDropValidation::GetTargetSlot(const FDragDropContext& Context)
@@ -316,8 +356,12 @@ const FInventorySlot* UInventoryDragDropValidation::GetTargetSlot(const FDragDro
 		return nullptr;
 	}
 
-	FInventorySlots* TargetGroup = Context.TargetInventory->GetInventorySlotsGroup().GetGroupByID(
-		Context.TargetGroupIndex);
+	if (Context.TargetHandle.IsSet())
+	{
+		return Context.TargetInventory->GetInventorySlotsGroup().ResolveHandle(Context.TargetHandle);
+	}
+
+	const FInventorySlots* TargetGroup = GetTargetGroup(Context);
 	if (!TargetGroup)
 	{
 		return nullptr;
@@ -326,6 +370,36 @@ const FInventorySlot* UInventoryDragDropValidation::GetTargetSlot(const FDragDro
 	return TargetGroup->GetSlotAtIndex(Context.TargetSlotIndex);
 }
 
+const FInventorySlots* UInventoryDragDropValidation::GetTargetGroup(const FDragDropContext& Context)
+{
+	if (!Context.TargetInventory)
+	{
+		return nullptr;
+	}
+
+	const FInventorySlotsGroup& Groups = Context.TargetInventory->GetInventorySlotsGroup();
+	if (Context.TargetHandle.IsSet())
+	{
+		return Groups.GetGroupByIndex(Context.TargetHandle.GroupIndex);
+	}
+
+	return Groups.GetGroupByID(Context.TargetGroupIndex);
+}
+
+bool UInventoryDragDropValidation::ResolveContextSlot(const UInventoryComponent* Inventory,
+                                                      const FInventorySlotHandle& Handle, int32 GroupTypeID,
+                                                      int32 SlotIndex, int32& OutTypeID, int32& OutSlotIndex)
+{
+	if (Handle.IsSet() && Inventory)
+	{
+		return Inventory->ResolveSlotHandle(Handle, OutTypeID, OutSlotIndex);
+	}
+
+	OutTypeID = GroupTypeID;
+	OutSlotIndex = SlotIndex;
+	return true;
+}
+
 
 FDragDropValidationResult UInventoryDragDropValidation::RunCustomValidators(const FDragDropContext& Context)
 {
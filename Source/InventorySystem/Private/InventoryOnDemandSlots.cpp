@@ -0,0 +1,21 @@
+#include "InventoryOnDemandSlots.h"
+#include "InventoryComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+void UInventoryOnDemandSlots::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Clients create this under the same component, so entries apply to it before the component's reference replicates
+	Slots.Owner = GetTypedOuter<UInventoryComponent>();
+}
+
+void UInventoryOnDemandSlots::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryOnDemandSlots, Slots, PushParams);
+}
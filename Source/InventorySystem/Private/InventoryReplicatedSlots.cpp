@@ -0,0 +1,137 @@
+#include "Struct/InventoryReplicatedSlots.h"
+#include "InventoryComponent.h"
+
+bool FInventoryReplicatedSlot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	SerializeInventoryIndex(Ar, GroupIndex);
+	SerializeInventoryIndex(Ar, SlotIndex);
+
+	uint8 bValueStack = Ar.IsSaving() ? (ValueClassIndex != INDEX_NONE) : 0;
+	Ar.SerializeBits(&bValueStack, 1);
+
+	if (bValueStack)
+	{
+		SerializeInventoryIndex(Ar, ValueClassIndex);
+		if (Ar.IsLoading())
+		{
+			// Looked up in the owner's class table when the entry is applied
+			Item = nullptr;
+			ValueItemClass = nullptr;
+		}
+	}
+	else
+	{
+		UObject* Object = Item;
+		Map->SerializeObject(Ar, UItemBase::StaticClass(), Object);
+		if (Ar.IsLoading())
+		{
+			Item = Cast<UItemBase>(Object);
+			ValueItemClass = nullptr;
+			ValueClassIndex = INDEX_NONE;
+		}
+	}
+
+	SerializeInventoryQuantity(Ar, Quantity);
+
+	bOutSuccess = true;
+	return true;
+}
+
+void FInventoryReplicatedSlot::PreReplicatedRemove(const FInventoryReplicatedSlotArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->ApplyReplicatedSlot(GroupIndex, SlotIndex, nullptr, nullptr, 0);
+	}
+}
+
+void FInventoryReplicatedSlot::PostReplicatedAdd(const FInventoryReplicatedSlotArray& InArraySerializer)
+{
+	PostReplicatedChange(InArraySerializer);
+}
+
+void FInventoryReplicatedSlot::PostReplicatedChange(const FInventoryReplicatedSlotArray& InArraySerializer)
+{
+	if (!InArraySerializer.Owner)
+	{
+		return;
+	}
+
+	if (ValueClassIndex != INDEX_NONE)
+	{
+		ValueItemClass = InArraySerializer.Owner->ResolveValueItemClass(ValueClassIndex);
+	}
+
+	// An unresolved value stack waits for the class table; its OnRep applies the entry
+	if (IsResolved())
+	{
+		InArraySerializer.Owner->ApplyReplicatedSlot(GroupIndex, SlotIndex, Item, ValueItemClass, Quantity);
+	}
+}
+
+void FInventoryReplicatedSlotArray::SetSlot(int32 GroupIndex, int32 SlotIndex, UItemBase* Item,
+                                            TSubclassOf<UItemBase> ValueItemClass, int32 Quantity)
+{
+	const TPair<int32, int32> Key(GroupIndex, SlotIndex);
+	const int32* EntryIndex = EntryLookup.Find(Key);
+	if (Item)
+	{
+		ValueItemClass = nullptr;
+	}
+	const bool bEmpty = (Item == nullptr && ValueItemClass == nullptr) || Quantity <= 0;
+
+	if (bEmpty)
+	{
+		if (EntryIndex)
+		{
+			RemoveEntry(*EntryIndex);
+		}
+		return;
+	}
+
+	const int32 ValueClassIndex = (ValueItemClass && Owner) ? Owner->FindOrAddValueItemClass(ValueItemClass) : INDEX_NONE;
+
+	if (EntryIndex)
+	{
+		FInventoryReplicatedSlot& Entry = Entries[*EntryIndex];
+		if (Entry.Item != Item || Entry.ValueItemClass != ValueItemClass || Entry.Quantity != Quantity)
+		{
+			Entry.Item = Item;
+			Entry.ValueItemClass = ValueItemClass;
+			Entry.ValueClassIndex = ValueClassIndex;
+			Entry.Quantity = Quantity;
+			MarkItemDirty(Entry);
+		}
+		return;
+	}
+
+	FInventoryReplicatedSlot& Entry = Entries.AddDefaulted_GetRef();
+	Entry.GroupIndex = GroupIndex;
+	Entry.SlotIndex = SlotIndex;
+	Entry.Item = Item;
+	Entry.ValueItemClass = ValueItemClass;
+	Entry.ValueClassIndex = ValueClassIndex;
+	Entry.Quantity = Quantity;
+	MarkItemDirty(Entry);
+	EntryLookup.Add(Key, Entries.Num() - 1);
+}
+
+void FInventoryReplicatedSlotArray::ResolveValueItemClasses()
+{
+	if (!Owner)
+	{
+		return;
+	}
+
+	for (FInventoryReplicatedSlot& Entry : Entries)
+	{
+		if (!Entry.IsResolved())
+		{
+			Entry.ValueItemClass = Owner->ResolveValueItemClass(Entry.ValueClassIndex);
+			if (Entry.IsResolved())
+			{
+				Owner->ApplyReplicatedSlot(Entry.GroupIndex, Entry.SlotIndex, nullptr, Entry.ValueItemClass, Entry.Quantity);
+			}
+		}
+	}
+}
@@ -5,6 +5,7 @@ TArray<FInventorySearchResult> UInventorySearchFilter::SearchItems(const TArray<
                                                                    const FInventoryFilterCriteria& Criteria)
 {
 	TArray<FInventorySearchResult> Results;
+	const FInventoryTypeMask TypeMask(Criteria.TypeIDs);
 
 	for (int32 i = 0; i < Items.Num(); ++i)
 	{
@@ -14,7 +15,7 @@ TArray<FInventorySearchResult> UInventorySearchFilter::SearchItems(const TArray<
 			continue;
 		}
 
-		if (MatchesCriteria(Item, Criteria))
+		if (MatchesCriteria(Item, Criteria, TypeMask))
 		{
 			FInventorySearchResult Result;
 			Result.Item = Item;
@@ -72,22 +73,13 @@ TArray<UItemBase*> UInventorySearchFilter::FilterByType(const TArray<UItemBase*>
 		return Items;
 	}
 
+	const FInventoryTypeMask TypeMask(TypeIDs);
+
 	for (UItemBase* Item : Items)
 	{
-		if (!IsValid(Item))
-		{
-			continue;
-		}
-
-		const TArray<int32>& ItemTypes = Item->GetItemDefinition().GetInventorySlotTypeIDs();
-
-		for (int32 TypeID : TypeIDs)
+		if (IsValid(Item) && Item->GetItemDefinition().GetSlotTypeMask().Intersects(TypeMask))
 		{
-			if (ItemTypes.Contains(TypeID))
-			{
-				Results.Add(Item);
-				break;
-			}
+			Results.Add(Item);
 		}
 	}
 
@@ -140,6 +132,12 @@ TArray<UItemBase*> UInventorySearchFilter::FilterStackable(const TArray<UItemBas
 }
 
 bool UInventorySearchFilter::MatchesCriteria(const UItemBase* Item, const FInventoryFilterCriteria& Criteria)
+{
+	return MatchesCriteria(Item, Criteria, FInventoryTypeMask(Criteria.TypeIDs));
+}
+
+bool UInventorySearchFilter::MatchesCriteria(const UItemBase* Item, const FInventoryFilterCriteria& Criteria,
+                                             const FInventoryTypeMask& TypeMask)
 {
 	if (!IsValid(Item))
 	{
@@ -172,24 +170,9 @@ bool UInventorySearchFilter::MatchesCriteria(const UItemBase* Item, const FInven
 	}
 
 	// Type filter
-	if (Criteria.TypeIDs.Num() > 0)
+	if (!TypeMask.IsEmpty() && !Item->GetItemDefinition().GetSlotTypeMask().Intersects(TypeMask))
 	{
-		const TArray<int32>& ItemTypes = Item->GetItemDefinition().GetInventorySlotTypeIDs();
-		bool bTypeMatch = false;
-
-		for (int32 TypeID : Criteria.TypeIDs)
-		{
-			if (ItemTypes.Contains(TypeID))
-			{
-				bTypeMatch = true;
-				break;
-			}
-		}
-
-		if (!bTypeMatch)
-		{
-			return false;
-		}
+		return false;
 	}
 
 	// Rarity filter
@@ -68,9 +68,9 @@ bool UInventorySortingSystem::CompareItems(const UItemBase* A, const UItemBase*
 
 	case EInventorySortType::IST_Type:
 		{
-			FString TypeA = A->GetItemDefinition().GetItemID();
-			FString TypeB = B->GetItemDefinition().GetItemID();
-			bResult = TypeA < TypeB;
+			const FItemDefinition& DefA = A->GetItemDefinition();
+			const FItemDefinition& DefB = B->GetItemDefinition();
+			bResult = DefA.GetItemKey() != DefB.GetItemKey() && DefA.GetItemID() < DefB.GetItemID();
 			break;
 		}
 
@@ -198,7 +198,8 @@ void FInventorySystemModule::RegisterConsoleCommands()
 			if (DS)
 			{
 				DS->GetOperationTracker().Reset();
-				UE_LOG(LogInventory, Log, TEXT("Operation tracker stats reset"));
+				DS->ResetNetCostStats();
+				UE_LOG(LogInventory, Log, TEXT("Operation tracker and net cost stats reset"));
 			}
 
 			UItemPoolSubsystem* PS = GetPoolSubsystem();
@@ -215,6 +216,44 @@ void FInventorySystemModule::RegisterConsoleCommands()
 		ECVF_Default
 	));
 
+	// Inventory.Debug.NetTop [Count]
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Inventory.Debug.NetTop"),
+		TEXT("Print the inventories with the highest replication cost. Usage: Inventory.Debug.NetTop [Count=10, 0=all]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			UInventoryDebugSubsystem* DS = GetDebugSubsystem();
+			if (!DS)
+			{
+				UE_LOG(LogInventory, Warning, TEXT("No InventoryDebugSubsystem found"));
+				return;
+			}
+
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10;
+			UE_LOG(LogInventory, Log, TEXT("\n%s"), *DS->GetNetCostSummary(Count));
+		}),
+		ECVF_Default
+	));
+
+	// Inventory.Debug.NetReset
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Inventory.Debug.NetReset"),
+		TEXT("Reset the replication counters of every inventory"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (UInventoryDebugSubsystem* DS = GetDebugSubsystem())
+			{
+				DS->ResetNetCostStats();
+				UE_LOG(LogInventory, Log, TEXT("Inventory net cost stats reset"));
+			}
+			else
+			{
+				UE_LOG(LogInventory, Warning, TEXT("No InventoryDebugSubsystem found"));
+			}
+		}),
+		ECVF_Default
+	));
+
 	// Inventory.Debug.FrameTracking <0|1>
 	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
 		TEXT("Inventory.Debug.FrameTracking"),
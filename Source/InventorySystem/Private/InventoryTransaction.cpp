@@ -0,0 +1,529 @@
+#include "InventoryTransaction.h"
+#include "InventoryComponent.h"
+#include "InventoryDebugSubsystem.h"
+#include "InventorySystem.h"
+#include "PoolSystem/ItemPoolSubsystem.h"
+
+bool FInventoryTransaction::StageRemove(UInventoryComponent* Inventory, int32 TypeID, int32 SlotIndex, int32 Quantity)
+{
+	if (bFailed)
+	{
+		return false;
+	}
+
+	const int32 EntryIndex = TouchSlot(Inventory, ResolveGroupIndex(Inventory, TypeID), SlotIndex);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return Fail(FString::Printf(TEXT("Remove: slot %d in group %d does not exist"), SlotIndex, TypeID));
+	}
+
+	FJournalEntry& Entry = Journal[EntryIndex];
+	if (Entry.IsEmpty())
+	{
+		return Fail(FString::Printf(TEXT("Remove: slot %d in group %d is empty"), SlotIndex, TypeID));
+	}
+
+	const int32 Amount = Quantity < 0 ? Entry.Quantity : Quantity;
+	if (Amount <= 0 || Amount > Entry.Quantity)
+	{
+		return Fail(FString::Printf(TEXT("Remove: cannot take %d from a stack of %d"), Amount, Entry.Quantity));
+	}
+
+	Entry.Quantity -= Amount;
+	if (Entry.Quantity == 0)
+	{
+		Entry.Item = nullptr;
+	}
+
+	return true;
+}
+
+bool FInventoryTransaction::StageMove(UInventoryComponent* From, int32 FromTypeID, int32 FromSlotIndex,
+                                      UInventoryComponent* To, int32 ToTypeID, int32 ToSlotIndex, int32 Quantity)
+{
+	if (bFailed)
+	{
+		return false;
+	}
+
+	const int32 SourceIndex = TouchSlot(From, ResolveGroupIndex(From, FromTypeID), FromSlotIndex);
+	if (SourceIndex == INDEX_NONE || Journal[SourceIndex].IsEmpty())
+	{
+		return Fail(FString::Printf(TEXT("Move: source slot %d in group %d is empty or invalid"), FromSlotIndex, FromTypeID));
+	}
+
+	UItemBase* Item = Journal[SourceIndex].Item;
+	const int32 Amount = Quantity < 0 ? Journal[SourceIndex].Quantity : Quantity;
+	if (Amount <= 0 || Amount > Journal[SourceIndex].Quantity)
+	{
+		return Fail(FString::Printf(TEXT("Move: cannot take %d from a stack of %d"), Amount, Journal[SourceIndex].Quantity));
+	}
+
+	const bool bWholeStack = Amount == Journal[SourceIndex].Quantity;
+	const bool bAnyGroup = ToTypeID == -1 && ToSlotIndex == INDEX_NONE;
+	const int32 DestGroupIndex = ResolveGroupIndex(To, ToTypeID);
+	const FInventorySlots* DestGroup = To ? To->GetInventorySlotsGroup().GetGroupByIndex(DestGroupIndex) : nullptr;
+	if (!To || (!bAnyGroup && (!DestGroup || !DestGroup->IsTypeSupported(Item))))
+	{
+		return Fail(FString::Printf(TEXT("Move: group %d does not accept this item"), ToTypeID));
+	}
+
+	// Take the units out first so the source slot reads as free if the destination search reaches it
+	Journal[SourceIndex].Quantity -= Amount;
+	if (bWholeStack)
+	{
+		Journal[SourceIndex].Item = nullptr;
+	}
+
+	if (ToSlotIndex == INDEX_NONE)
+	{
+		if (!bWholeStack && !Item->IsStackable())
+		{
+			return Fail(TEXT("Move: only stackable items can be moved in part"));
+		}
+
+		int32 Remaining = Amount;
+		if (bAnyGroup)
+		{
+			const TArray<FInventorySlots>& Groups = To->GetInventorySlotsGroup().GetInventoryGroups();
+			for (int32 GroupIndex = 0; GroupIndex < Groups.Num() && Remaining > 0; ++GroupIndex)
+			{
+				if (Groups[GroupIndex].IsTypeSupported(Item))
+				{
+					Remaining = StagePlace(To, GroupIndex, Item, Remaining, SourceIndex);
+				}
+			}
+		}
+		else
+		{
+			Remaining = StagePlace(To, DestGroupIndex, Item, Amount, SourceIndex);
+		}
+
+		if (Remaining > 0)
+		{
+			return Fail(FString::Printf(TEXT("Move: group %d has no room for %d units"), ToTypeID, Amount));
+		}
+
+		return true;
+	}
+
+	const int32 DestIndex = TouchSlot(To, DestGroupIndex, ToSlotIndex);
+	if (DestIndex == INDEX_NONE)
+	{
+		return Fail(FString::Printf(TEXT("Move: target slot %d in group %d does not exist"), ToSlotIndex, ToTypeID));
+	}
+
+	FJournalEntry& Dest = Journal[DestIndex];
+	if (Dest.IsEmpty())
+	{
+		// A value stack has no object to hand over, so any part of it can start a new stack
+		if (!bWholeStack && !Item->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			return Fail(TEXT("Move: a partial stack can only be merged into an existing stack"));
+		}
+
+		Dest.Item = Item;
+		Dest.Quantity = Amount;
+		Dest.MaxStack = Item->GetMaxStackSize();
+		return true;
+	}
+
+	if (!Item->IsStackable() || Dest.Item->GetItemDefinition().GetItemKey() != Item->GetItemDefinition().GetItemKey())
+	{
+		return Fail(FString::Printf(TEXT("Move: target slot %d holds a different item"), ToSlotIndex));
+	}
+
+	if (Dest.GetRoom() < Amount)
+	{
+		return Fail(FString::Printf(TEXT("Move: target stack has room for %d, %d requested"), Dest.GetRoom(), Amount));
+	}
+
+	Dest.Quantity += Amount;
+	return true;
+}
+
+bool FInventoryTransaction::StageAdd(UInventoryComponent* Inventory, UItemBase* Item, int32 TargetTypeID)
+{
+	if (bFailed)
+	{
+		return false;
+	}
+
+	if (!Inventory || !IsValid(Item) || Item->GetCurrentStackSize() <= 0)
+	{
+		return Fail(TEXT("Add: invalid inventory or item"));
+	}
+
+	const FInventorySlotsGroup& Groups = Inventory->GetInventorySlotsGroup();
+	const int32 Amount = Item->GetCurrentStackSize();
+
+	if (TargetTypeID != -1)
+	{
+		const int32 GroupIndex = ResolveGroupIndex(Inventory, TargetTypeID);
+		const FInventorySlots* Group = Groups.GetGroupByIndex(GroupIndex);
+		if (!Group || !Group->IsTypeSupported(Item))
+		{
+			return Fail(FString::Printf(TEXT("Add: group %d does not accept this item"), TargetTypeID));
+		}
+
+		if (StagePlace(Inventory, GroupIndex, Item, Amount) > 0)
+		{
+			return Fail(FString::Printf(TEXT("Add: group %d has no room for %d units"), TargetTypeID, Amount));
+		}
+
+		return true;
+	}
+
+	int32 Remaining = Amount;
+	for (int32 GroupIndex = 0; GroupIndex < Groups.GetInventoryGroups().Num() && Remaining > 0; ++GroupIndex)
+	{
+		if (Groups.GetInventoryGroups()[GroupIndex].IsTypeSupported(Item))
+		{
+			Remaining = StagePlace(Inventory, GroupIndex, Item, Remaining);
+		}
+	}
+
+	if (Remaining > 0)
+	{
+		return Fail(FString::Printf(TEXT("Add: no room for %d of %d units"), Remaining, Amount));
+	}
+
+	return true;
+}
+
+FInventoryOperationResult FInventoryTransaction::Commit()
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	UWorld* World = Journal.Num() > 0 && Journal[0].Inventory ? Journal[0].Inventory->GetWorld() : nullptr;
+
+	if (bFailed)
+	{
+		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(Error);
+		Rollback();
+		TrackInventoryOperation(World, EInventoryOperationType::IOT_Transaction, FailResult,
+			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("Staging failed"));
+		return FailResult;
+	}
+
+	TArray<UInventoryComponent*, TInlineAllocator<2>> Inventories;
+	for (const FJournalEntry& Entry : Journal)
+	{
+		Inventories.AddUnique(Entry.Inventory);
+	}
+
+	for (UInventoryComponent* Inventory : Inventories)
+	{
+		if (!IsValid(Inventory) || !Inventory->GetOwner() || !Inventory->GetOwner()->HasAuthority())
+		{
+			UE_LOG(LogInventory, Warning, TEXT("FInventoryTransaction::Commit: No authority over a staged inventory"));
+			FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(TEXT("No authority or no owner"));
+			Rollback();
+			TrackInventoryOperation(World, EInventoryOperationType::IOT_Transaction, FailResult,
+				static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("No authority"));
+			return FailResult;
+		}
+	}
+
+	for (const FJournalEntry& Entry : Journal)
+	{
+		const FInventorySlots* Group = Entry.Inventory->GetInventorySlotsGroup().GetGroupByIndex(Entry.GroupIndex);
+		const FInventorySlot* Slot = Group ? Group->GetSlotAtIndex(Entry.SlotIndex) : nullptr;
+		const bool bUnchanged = Slot
+			&& GetJournalItem(*Slot) == Entry.OriginalItem
+			&& Slot->GetCurrentStackSize() == Entry.OriginalQuantity
+			&& Group->GetSlotGeneration(Entry.SlotIndex) == Entry.OriginalGeneration;
+
+		if (!bUnchanged)
+		{
+			FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(
+				TEXT("Slot %d in group %d changed after it was staged"), Entry.SlotIndex, Entry.GroupIndex));
+			UE_LOG(LogInventory, Warning, TEXT("FInventoryTransaction::Commit: %s"), *FailResult.Message);
+			Rollback();
+			TrackInventoryOperation(World, EInventoryOperationType::IOT_Transaction, FailResult,
+				static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), TEXT("Stale journal"));
+			return FailResult;
+		}
+	}
+
+	// Validation passed; nothing below can fail
+	int32 WrittenSlots = 0;
+	for (const FJournalEntry& Entry : Journal)
+	{
+		if (Entry.IsDirty())
+		{
+			FInventorySlots* Group = Entry.Inventory->GetInventorySlotsGroup().GetGroupByIndex(Entry.GroupIndex);
+			if (Entry.IsValueStack())
+			{
+				Group->SetValueStackContents(Entry.SlotIndex, Entry.Item->GetClass(), Entry.Quantity);
+			}
+			else
+			{
+				Group->SetSlotContents(Entry.SlotIndex, Entry.IsEmpty() ? nullptr : Entry.Item, Entry.Quantity);
+			}
+			++WrittenSlots;
+		}
+	}
+
+	// An item object sits in at most one slot, so comparing journaled slots is enough to tell who moved where.
+	// Value stacks have no object to track.
+	TMap<UItemBase*, UInventoryComponent*> OldOwners;
+	TMap<UItemBase*, const FJournalEntry*> NewHomes;
+	for (const FJournalEntry& Entry : Journal)
+	{
+		if (Entry.OriginalItem && !Entry.OriginalItem->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			OldOwners.Add(Entry.OriginalItem, Entry.Inventory);
+		}
+		if (!Entry.IsEmpty() && !Entry.IsValueStack())
+		{
+			NewHomes.Add(Entry.Item, &Entry);
+		}
+	}
+
+	TSet<UItemBase*> DepartedItems;
+	TArray<UItemBase*> SpentItems;
+	for (const TPair<UItemBase*, UInventoryComponent*>& Pair : OldOwners)
+	{
+		const FJournalEntry* const* NewHome = NewHomes.Find(Pair.Key);
+		if (NewHome && (*NewHome)->Inventory == Pair.Value)
+		{
+			continue;
+		}
+
+		Pair.Key->OnRemovedFromInventory();
+		DepartedItems.Add(Pair.Key);
+
+		if (!NewHome)
+		{
+			// Every unit was removed or merged into other stacks, so the object is spent
+			SpentItems.Add(Pair.Key);
+		}
+		else if (Pair.Key->GetOuter() != (*NewHome)->Inventory)
+		{
+			Pair.Key->Rename(nullptr, (*NewHome)->Inventory);
+		}
+	}
+
+	for (UInventoryComponent* Inventory : Inventories)
+	{
+		const FInventorySlotsGroup& Groups = Inventory->GetInventorySlotsGroup();
+		TArray<FInventorySlotHandle> ChangedSlots;
+		TArray<FInventoryBatchAddEntry> AddedEntries;
+		TArray<const FJournalEntry*> RemovedEntries;
+
+		for (const FJournalEntry& Entry : Journal)
+		{
+			if (Entry.Inventory != Inventory || !Entry.IsDirty())
+			{
+				continue;
+			}
+
+			const FInventorySlotHandle Handle = Groups.MakeSlotHandle(Entry.GroupIndex, Entry.SlotIndex);
+			ChangedSlots.Add(Handle);
+
+			if (Entry.OriginalItem && DepartedItems.Contains(Entry.OriginalItem))
+			{
+				RemovedEntries.Add(&Entry);
+			}
+
+			if (Entry.IsEmpty() || Entry.IsValueStack() || Entry.Item == Entry.OriginalItem)
+			{
+				continue;
+			}
+
+			UInventoryComponent* const* OldOwner = OldOwners.Find(Entry.Item);
+			if (!OldOwner || *OldOwner != Inventory)
+			{
+				Entry.Item->OnAddedToInventory(Inventory->GetOwner());
+
+				FInventoryBatchAddEntry& Added = AddedEntries.AddDefaulted_GetRef();
+				Added.Item = Entry.Item;
+				Added.Result = FInventoryOperationResult::Ok();
+				Added.AddedQuantity = Entry.Quantity;
+				Added.TypeID = Groups.GetTypeIDForGroupIndex(Entry.GroupIndex);
+				Added.SlotIndex = Entry.SlotIndex;
+				Added.Handle = Handle;
+			}
+		}
+
+		if (ChangedSlots.Num() > 0)
+		{
+			Inventory->OnSlotsChanged.Broadcast(ChangedSlots);
+		}
+
+		for (const FJournalEntry* Entry : RemovedEntries)
+		{
+			Inventory->BroadcastItemRemoved(Entry->OriginalItem, Groups.GetTypeIDForGroupIndex(Entry->GroupIndex),
+				Entry->SlotIndex, FInventorySlotHandle(Entry->GroupIndex, Entry->SlotIndex, Entry->OriginalGeneration));
+		}
+
+		if (AddedEntries.Num() > 0)
+		{
+			Inventory->OnItemsAdded.Broadcast(AddedEntries);
+		}
+	}
+
+	// Returned after the events so listeners still see the objects as they were
+	if (SpentItems.Num() > 0 && World)
+	{
+		if (UItemPoolSubsystem* PoolSubsystem = World->GetSubsystem<UItemPoolSubsystem>())
+		{
+			PoolSubsystem->ReturnItemsToPool(SpentItems);
+		}
+	}
+
+	const FString Context = FString::Printf(TEXT("Slots:%d Inventories:%d"), WrittenSlots, Inventories.Num());
+	Rollback();
+
+	FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
+	TrackInventoryOperation(World, EInventoryOperationType::IOT_Transaction, OkResult,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), Context);
+	return OkResult;
+}
+
+void FInventoryTransaction::Rollback()
+{
+	Journal.Reset();
+	JournalLookup.Reset();
+	Error.Reset();
+	bFailed = false;
+}
+
+int32 FInventoryTransaction::TouchSlot(UInventoryComponent* Inventory, int32 GroupIndex, int32 SlotIndex)
+{
+	if (!Inventory)
+	{
+		return INDEX_NONE;
+	}
+
+	const TTuple<const UInventoryComponent*, int32, int32> Key(Inventory, GroupIndex, SlotIndex);
+	if (const int32* Existing = JournalLookup.Find(Key))
+	{
+		return *Existing;
+	}
+
+	const FInventorySlots* Group = Inventory->GetInventorySlotsGroup().GetGroupByIndex(GroupIndex);
+	const FInventorySlot* Slot = Group ? Group->GetSlotAtIndex(SlotIndex) : nullptr;
+	if (!Slot)
+	{
+		return INDEX_NONE;
+	}
+
+	FJournalEntry& Entry = Journal.AddDefaulted_GetRef();
+	Entry.Inventory = Inventory;
+	Entry.GroupIndex = GroupIndex;
+	Entry.SlotIndex = SlotIndex;
+	Entry.OriginalItem = GetJournalItem(*Slot);
+	Entry.OriginalQuantity = Slot->GetCurrentStackSize();
+	Entry.OriginalGeneration = Group->GetSlotGeneration(SlotIndex);
+	Entry.Item = Entry.OriginalItem;
+	Entry.Quantity = Entry.OriginalQuantity;
+	Entry.MaxStack = Slot->GetMaxStackSize();
+
+	const int32 EntryIndex = Journal.Num() - 1;
+	JournalLookup.Add(Key, EntryIndex);
+	return EntryIndex;
+}
+
+bool FInventoryTransaction::FJournalEntry::IsValueStack() const
+{
+	return !IsEmpty() && Item->HasAnyFlags(RF_ClassDefaultObject);
+}
+
+UItemBase* FInventoryTransaction::GetJournalItem(const FInventorySlot& Slot)
+{
+	if (Slot.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return Slot.GetItem() ? Slot.GetItem() : Slot.GetItemClass()->GetDefaultObject<UItemBase>();
+}
+
+int32 FInventoryTransaction::ResolveGroupIndex(const UInventoryComponent* Inventory, int32 TypeID) const
+{
+	if (!Inventory)
+	{
+		return INDEX_NONE;
+	}
+
+	return Inventory->GetInventorySlotsGroup().GetGroupIndexByID(TypeID);
+}
+
+int32 FInventoryTransaction::StagePlace(UInventoryComponent* Inventory, int32 GroupIndex, UItemBase* Item, int32 Quantity,
+                                       int32 SkipEntry)
+{
+	const FInventorySlots* Group = Inventory->GetInventorySlotsGroup().GetGroupByIndex(GroupIndex);
+	if (!Group)
+	{
+		return Quantity;
+	}
+
+	const int32 SlotCount = Group->GetSlots().Num();
+	const uint64 ItemKey = Item->GetItemDefinition().GetItemKey();
+
+	if (Item->IsStackable())
+	{
+		for (int32 SlotIndex = 0; SlotIndex < SlotCount && Quantity > 0; ++SlotIndex)
+		{
+			const int32* Journaled = JournalLookup.Find(MakeTuple(static_cast<const UInventoryComponent*>(Inventory), GroupIndex, SlotIndex));
+			const FInventorySlot& Slot = Group->GetSlots()[SlotIndex];
+			const bool bHasRoom = Journaled
+				? *Journaled != SkipEntry && Journal[*Journaled].GetRoom() > 0 && Journal[*Journaled].Item->GetItemDefinition().GetItemKey() == ItemKey
+				: !Slot.IsEmpty() && !Slot.IsFull() && Slot.GetItemPrototype()->GetItemDefinition().GetItemKey() == ItemKey;
+
+			if (bHasRoom)
+			{
+				FJournalEntry& Entry = Journal[TouchSlot(Inventory, GroupIndex, SlotIndex)];
+				const int32 Moved = FMath::Min(Quantity, Entry.GetRoom());
+				Entry.Quantity += Moved;
+				Quantity -= Moved;
+			}
+		}
+	}
+
+	// The item object can only occupy one slot, so a second free slot would need a split. A value stack can start any number.
+	const bool bValueStack = Item->HasAnyFlags(RF_ClassDefaultObject);
+	for (int32 SlotIndex = 0; SlotIndex < SlotCount && Quantity > 0 && (bValueStack || !IsItemStaged(Item)); ++SlotIndex)
+	{
+		const int32* Journaled = JournalLookup.Find(MakeTuple(static_cast<const UInventoryComponent*>(Inventory), GroupIndex, SlotIndex));
+		const bool bFree = Journaled ? Journal[*Journaled].IsEmpty() : Group->GetSlots()[SlotIndex].IsEmpty();
+		if (!bFree)
+		{
+			continue;
+		}
+
+		FJournalEntry& Entry = Journal[TouchSlot(Inventory, GroupIndex, SlotIndex)];
+		Entry.Item = Item;
+		Entry.MaxStack = Item->GetMaxStackSize();
+		Entry.Quantity = FMath::Min(Quantity, Entry.MaxStack);
+		Quantity -= Entry.Quantity;
+	}
+
+	return Quantity;
+}
+
+bool FInventoryTransaction::IsItemStaged(const UItemBase* Item) const
+{
+	for (const FJournalEntry& Entry : Journal)
+	{
+		if (Entry.Item == Item && !Entry.IsEmpty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FInventoryTransaction::Fail(const FString& Reason)
+{
+	if (!bFailed)
+	{
+		bFailed = true;
+		Error = Reason;
+	}
+
+	return false;
+}
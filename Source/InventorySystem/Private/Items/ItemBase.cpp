@@ -1,7 +1,9 @@
 #include "Items/ItemBase.h"
 #include "InventorySystem.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/ActorChannel.h"
+#include "Net/NetworkSubsystem.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "Serialization/ArchiveSaveCompressedProxy.h"
 #include "InventoryComponent.h"
@@ -20,13 +22,19 @@ void UItemBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetim
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UItemBase, CurrentStackSize);
-	DOREPLIFETIME(UItemBase, bIsInInventory);
-	DOREPLIFETIME(UItemBase, OwnerActor);
-	DOREPLIFETIME(UItemBase, OwnerInventoryComponent);
-	DOREPLIFETIME(UItemBase, ItemModules);
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
 
-	DOREPLIFETIME_CONDITION(UItemBase, ItemDefinition, COND_InitialOnly);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, CurrentStackSize, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, bIsInInventory, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, OwnerActor, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, OwnerInventoryComponent, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, ItemModules, PushParams);
+
+	FDoRepLifetimeParams InitialOnlyParams;
+	InitialOnlyParams.bIsPushBased = true;
+	InitialOnlyParams.Condition = COND_InitialOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemBase, ItemDefinition, InitialOnlyParams);
 }
 
 bool UItemBase::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
@@ -55,6 +63,19 @@ UWorld* UItemBase::GetWorld() const
 	return nullptr;
 }
 
+#if WITH_EDITOR
+void UItemBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	ItemDefinition.RefreshCachedData();
+}
+#endif
+
+void UItemBase::OnRep_ItemDefinition()
+{
+	ItemDefinition.RefreshCachedData();
+}
+
 FItemSaveData UItemBase::SaveToStruct(bool bCompress)
 {
 	FItemSaveData Data;
@@ -88,6 +109,7 @@ void UItemBase::LoadFromStruct(const FItemSaveData& Data)
 {
 	ItemDefinition.SetItemID(Data.ItemID);
 	CurrentStackSize = Data.StackSize;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, CurrentStackSize, this);
 
 	FMemoryReader MemoryReader(Data.ByteData, true);
 	FObjectAndNameAsStringProxyArchive Ar(MemoryReader, true);
@@ -107,6 +129,7 @@ void UItemBase::InitializeItem_Implementation()
 		MaxStackSize = 1;
 		CurrentStackSize = 1;
 	}
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, CurrentStackSize, this);
 
 	if (ItemDefinition.GetItemID().IsEmpty())
 	{
@@ -141,6 +164,7 @@ void UItemBase::SetCurrentStackSize(int32 NewSize)
 			UE_LOG(LogInventory, Warning, TEXT("Attempted to set stack size %d on non-stackable item"), NewSize);
 		}
 	}
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, CurrentStackSize, this);
 }
 
 bool UItemBase::CanMergeWith(const UItemBase* OtherItem) const
@@ -148,7 +172,7 @@ bool UItemBase::CanMergeWith(const UItemBase* OtherItem) const
 	if (!OtherItem || !bIsStackable)
 		return false;
 
-	return GetItemDefinition().GetItemID() == OtherItem->GetItemDefinition().GetItemID()
+	return GetItemDefinition().GetItemKey() == OtherItem->GetItemDefinition().GetItemKey()
 		&& CurrentStackSize < MaxStackSize;
 }
 
@@ -196,12 +220,14 @@ UItemBase* UItemBase::SplitStack(int32 Amount)
 	}
 
 	CurrentStackSize -= Amount;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, CurrentStackSize, this);
 
 	UItemBase* NewItem = NewObject<UItemBase>(GetTransientPackage(), GetClass());
 	if (!NewItem)
 	{
 		UE_LOG(LogInventory, Error, TEXT("Failed to create new item instance for split"));
 		CurrentStackSize += Amount;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, CurrentStackSize, this);
 		return nullptr;
 	}
 
@@ -218,6 +244,7 @@ UItemBase* UItemBase::SplitStack(int32 Amount)
 			if (UItemModuleBase* NewModule = Module->DuplicateModule(NewItem))
 			{
 				NewItem->ItemModules.Add(NewModule);
+				MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, ItemModules, NewItem);
 				if (Module->IsModuleActive())
 				{
 					Module->OnItemSplit(NewItem, Amount);
@@ -238,6 +265,8 @@ void UItemBase::OnAddedToInventory(AActor* NewOwner)
 
 	OwnerActor = NewOwner;
 	bIsInInventory = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, OwnerActor, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, bIsInInventory, this);
 
 	if (IsRooted())
 	{
@@ -266,6 +295,75 @@ void UItemBase::OnRemovedFromInventory()
 	bIsInInventory = false;
 	OwnerActor = nullptr;
 	OwnerInventoryComponent = nullptr;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, bIsInInventory, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, OwnerActor, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, OwnerInventoryComponent, this);
+}
+
+void UItemBase::RegisterReplicatedSubObjects(UActorComponent* Component, ELifetimeCondition Condition, FName NetGroup)
+{
+	if (!Component)
+		return;
+
+	if (Condition != COND_NetGroup)
+		NetGroup = NAME_None;
+
+	UActorComponent* Previous = ReplicationComponent.Get();
+	if (Previous && (Previous != Component || ReplicationCondition != Condition || ReplicationNetGroup != NetGroup))
+		UnregisterReplicatedSubObjects(Previous);
+
+	ReplicationComponent = Component;
+	ReplicationCondition = Condition;
+	ReplicationNetGroup = NetGroup;
+	AddReplicatedSubObject(Component, this);
+
+	for (UItemModuleBase* Module : ItemModules)
+	{
+		if (Module)
+			AddReplicatedSubObject(Component, Module);
+	}
+}
+
+void UItemBase::UnregisterReplicatedSubObjects(UActorComponent* Component)
+{
+	if (!Component)
+		return;
+
+	RemoveReplicatedSubObject(Component, this);
+
+	for (UItemModuleBase* Module : ItemModules)
+	{
+		if (Module)
+			RemoveReplicatedSubObject(Component, Module);
+	}
+
+	if (ReplicationComponent == Component)
+	{
+		ReplicationComponent.Reset();
+		ReplicationNetGroup = NAME_None;
+	}
+}
+
+void UItemBase::AddReplicatedSubObject(UActorComponent* Component, UObject* SubObject) const
+{
+	Component->AddReplicatedSubObject(SubObject, ReplicationCondition);
+
+	if (!ReplicationNetGroup.IsNone())
+	{
+		if (UNetworkSubsystem* NetSubsystem = Component->GetWorld() ? Component->GetWorld()->GetSubsystem<UNetworkSubsystem>() : nullptr)
+			NetSubsystem->GetNetConditionGroupManager().RegisterSubObjectInGroup(SubObject, ReplicationNetGroup);
+	}
+}
+
+void UItemBase::RemoveReplicatedSubObject(UActorComponent* Component, UObject* SubObject) const
+{
+	Component->RemoveReplicatedSubObject(SubObject);
+
+	if (!ReplicationNetGroup.IsNone())
+	{
+		if (UNetworkSubsystem* NetSubsystem = Component->GetWorld() ? Component->GetWorld()->GetSubsystem<UNetworkSubsystem>() : nullptr)
+			NetSubsystem->GetNetConditionGroupManager().UnregisterSubObjectFromGroup(SubObject, ReplicationNetGroup);
+	}
 }
 
 FInventoryOperationResult UItemBase::AddModule(UItemModuleBase* NewModule)
@@ -277,10 +375,14 @@ FInventoryOperationResult UItemBase::AddModule(UItemModuleBase* NewModule)
 		return FInventoryOperationResult::Fail(TEXT("Module of this class already exists on item"));
 
 	ItemModules.Add(NewModule);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, ItemModules, this);
 	NewModule->Initialize(this);
 
 	InvalidateModuleCache();
 
+	if (UActorComponent* Component = ReplicationComponent.Get())
+		AddReplicatedSubObject(Component, NewModule);
+
 	if (bIsInInventory)
 		NewModule->OnItemAddedToInventory(OwnerActor);
 
@@ -299,8 +401,12 @@ FInventoryOperationResult UItemBase::RemoveModule(UItemModuleBase* ModuleToRemov
 		ModuleToRemove->OnItemRemovedFromInventory();
 
 	ItemModules.Remove(ModuleToRemove);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemBase, ItemModules, this);
 	InvalidateModuleCache();
 
+	if (UActorComponent* Component = ReplicationComponent.Get())
+		RemoveReplicatedSubObject(Component, ModuleToRemove);
+
 	return FInventoryOperationResult::Ok();
 }
 
@@ -28,6 +28,7 @@ void UInventoryModuleBase::OnModuleInstalled_Implementation(UInventoryComponent*
 	if (!ParentInventoryComponent) return;
 	OwningInventory = ParentInventoryComponent;
 	ParentInventoryComponent->OnItemAdded.AddDynamic(this, &UInventoryModuleBase::OnItemAdded);
+	ParentInventoryComponent->OnItemsAdded.AddDynamic(this, &UInventoryModuleBase::OnItemsAdded);
 	ParentInventoryComponent->OnItemRemoved.AddDynamic(this, &UInventoryModuleBase::OnItemRemoved);
 }
 
@@ -35,6 +36,19 @@ void UInventoryModuleBase::OnModuleRemoved_Implementation()
 {
 	if (!OwningInventory) return;
 	OwningInventory->OnItemAdded.RemoveDynamic(this, &UInventoryModuleBase::OnItemAdded);
+	OwningInventory->OnItemsAdded.RemoveDynamic(this, &UInventoryModuleBase::OnItemsAdded);
 	OwningInventory->OnItemRemoved.RemoveDynamic(this, &UInventoryModuleBase::OnItemRemoved);
 	OwningInventory = nullptr;
 }
+
+void UInventoryModuleBase::OnItemsAdded_Implementation(const TArray<FInventoryBatchAddEntry>& Entries)
+{
+	if (!OwningInventory) return;
+	for (const FInventoryBatchAddEntry& Entry : Entries)
+	{
+		if (Entry.WasPlaced())
+		{
+			OnItemAdded(Entry.Item, Entry.TypeID, Entry.SlotIndex);
+		}
+	}
+}
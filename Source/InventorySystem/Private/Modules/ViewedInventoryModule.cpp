@@ -23,6 +23,8 @@ void UViewedInventoryModule::OnModuleInstalled_Implementation(UInventoryComponen
 	TMap<int32, FString> AllowedTypeMap;
 	AllowedTypeMap.Add(ViewSlotTypeID, TEXT("ViewedSlot"));
 	NewViewSlots.InitializeInventory(ViewSlotCount, AllowedTypeMap);
+	// Worn equipment is visible to everyone, unlike the rest of the inventory
+	NewViewSlots.SetReplicationPolicy(EInventoryGroupReplication::IGR_Public);
 
 	FInventorySlotsGroup& MasterGroup = ParentInventoryComponent->GetInventorySlotsGroup();
 
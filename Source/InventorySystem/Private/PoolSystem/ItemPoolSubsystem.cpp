@@ -120,31 +120,81 @@ void UItemPoolSubsystem::ReturnItemToPool(UItemBase* Item)
 	}
 
 	Pool->ActiveItems.Remove(Item);
+	StoreReturnedItem(*Pool, Item);
+}
+
+void UItemPoolSubsystem::ReturnItemsToPool(TArrayView<UItemBase* const> Items)
+{
+	if (!bEnablePooling)
+	{
+		return;
+	}
+
+	TMap<UClass*, TSet<UItemBase*>> ItemsByClass;
+	for (UItemBase* Item : Items)
+	{
+		if (Item)
+		{
+			ItemsByClass.FindOrAdd(Item->GetClass()).Add(Item);
+		}
+	}
+
+	for (TPair<UClass*, TSet<UItemBase*>>& Pair : ItemsByClass)
+	{
+		TSubclassOf<UItemBase> ItemClass = Pair.Key;
+		if (!ItemPools.Contains(ItemClass))
+		{
+			CreatePool(ItemClass);
+		}
+
+		FItemPool* Pool = ItemPools.Find(ItemClass);
+		if (!Pool)
+		{
+			continue;
+		}
+
+		// One pass over the active list with a hashed lookup, instead of one linear Remove per item
+		const TSet<UItemBase*>& Returning = Pair.Value;
+		Pool->ActiveItems.RemoveAllSwap([&Returning](UItemBase* Active)
+		{
+			return Returning.Contains(Active);
+		});
+
+		for (UItemBase* Item : Returning)
+		{
+			StoreReturnedItem(*Pool, Item);
+		}
+	}
+}
+
+void UItemPoolSubsystem::StoreReturnedItem(FItemPool& Pool, UItemBase* Item)
+{
+	TSubclassOf<UItemBase> ItemClass = Item->GetClass();
 
-	if (Pool->AvailableItems.Num() < Pool->MaxPoolSize)
+	if (Pool.AvailableItems.Num() < Pool.MaxPoolSize)
 	{
-		Pool->ReturnCount++;
+		Pool.ReturnCount++;
 		ResetItem(Item);
 
 		Item->Rename(nullptr, this);
 
-		Pool->AvailableItems.Add(Item);
+		Pool.AvailableItems.Add(Item);
 	}
 	else
 	{
-		if (Pool->bAutoGrow)
+		if (Pool.bAutoGrow)
 		{
-			Pool->ReturnCount++;
-			Pool->MaxPoolSize++;
+			Pool.ReturnCount++;
+			Pool.MaxPoolSize++;
 			ResetItem(Item);
 			Item->Rename(nullptr, this);
-			Pool->AvailableItems.Add(Item);
+			Pool.AvailableItems.Add(Item);
 			UE_LOG(LogInventory, Verbose, TEXT("Pool for %s auto-grew to size %d"), *ItemClass->GetName(),
-			       Pool->MaxPoolSize);
+			       Pool.MaxPoolSize);
 		}
 		else
 		{
-			Pool->OverflowCount++;
+			Pool.OverflowCount++;
 			if (UEngineItemPoolSubsystem* EnginePool = GEngine->GetEngineSubsystem<UEngineItemPoolSubsystem>())
 			{
 				EnginePool->ReturnItemToPool(Item);
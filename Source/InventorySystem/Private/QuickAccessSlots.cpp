@@ -1,6 +1,7 @@
 #include "QuickAccessSlots.h"
 #include "InventorySystem.h"
 #include "InventoryDebugSubsystem.h"
+#include "InventoryComponent.h"
 #include "Net/UnrealNetwork.h"
 
 UQuickAccessSlots::UQuickAccessSlots()
@@ -27,7 +28,7 @@ void UQuickAccessSlots::InitializeQuickSlots()
 	QuickSlots.SetNum(MaxQuickSlots);
 }
 
-FInventoryOperationResult UQuickAccessSlots::AssignToQuickSlot(int32 SlotIndex, UItemBase* Item, int32 SourceGroupIndex, int32 SourceSlotIndex)
+FInventoryOperationResult UQuickAccessSlots::AssignToQuickSlot(int32 SlotIndex, UItemBase* Item, const FInventorySlotHandle& SourceHandle)
 {
 	double StartTime = FPlatformTime::Seconds();
 
@@ -61,8 +62,7 @@ FInventoryOperationResult UQuickAccessSlots::AssignToQuickSlot(int32 SlotIndex,
 	}
 
 	QuickSlots[SlotIndex].Item = Item;
-	QuickSlots[SlotIndex].SourceGroupIndex = SourceGroupIndex;
-	QuickSlots[SlotIndex].SourceSlotIndex = SourceSlotIndex;
+	QuickSlots[SlotIndex].SourceHandle = SourceHandle;
 
 	OnQuickSlotChanged.Broadcast(SlotIndex, Item);
 
@@ -126,27 +126,64 @@ FQuickSlot UQuickAccessSlots::GetQuickSlot(int32 SlotIndex) const
 	return QuickSlots[SlotIndex];
 }
 
+FInventorySlotHandle UQuickAccessSlots::ResolveQuickSlotSource(int32 SlotIndex, UInventoryComponent* Inventory)
+{
+	if (!IsValidSlotIndex(SlotIndex) || !Inventory)
+	{
+		return FInventorySlotHandle();
+	}
+
+	FQuickSlot& QuickSlot = QuickSlots[SlotIndex];
+	if (!IsValid(QuickSlot.Item))
+	{
+		return FInventorySlotHandle();
+	}
+
+	if (!Inventory->IsSlotHandleValid(QuickSlot.SourceHandle))
+	{
+		QuickSlot.SourceHandle = Inventory->FindItemHandle(QuickSlot.Item);
+	}
+
+	return QuickSlot.SourceHandle;
+}
+
+FInventoryOperationResult UQuickAccessSlots::ValidateQuickSlotUse(int32 SlotIndex) const
+{
+	if (!IsValidSlotIndex(SlotIndex))
+	{
+		return FInventoryOperationResult::Fail(FString::Printf(TEXT("Invalid slot index %d"), SlotIndex));
+	}
+
+	if (!IsValid(QuickSlots[SlotIndex].Item))
+	{
+		return FInventoryOperationResult::Fail(FString::Printf(TEXT("Slot %d has no valid item"), SlotIndex));
+	}
+
+	return FInventoryOperationResult::Ok();
+}
+
 FInventoryOperationResult UQuickAccessSlots::UseQuickSlot(int32 SlotIndex)
 {
 	double StartTime = FPlatformTime::Seconds();
 
-	if (!IsValidSlotIndex(SlotIndex))
+	FInventoryOperationResult ValidationResult = ValidateQuickSlotUse(SlotIndex);
+	if (!ValidationResult.bSuccess)
 	{
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Invalid slot index %d"), SlotIndex));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_QuickSlotUse, FailResult,
+		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_QuickSlotUse, ValidationResult,
 			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-			FString::Printf(TEXT("Invalid index %d"), SlotIndex));
-		return FailResult;
+			FString::Printf(TEXT("Slot %d refused"), SlotIndex));
+		return ValidationResult;
 	}
 
 	UItemBase* Item = QuickSlots[SlotIndex].Item;
-	if (!IsValid(Item))
+
+	// The owning client announces the use at once and has the server confirm it
+	const AActor* Owner = GetOwner();
+	int32 PredictionKey = 0;
+	if (Owner && !Owner->HasAuthority() && Owner->GetNetConnection() != nullptr)
 	{
-		FInventoryOperationResult FailResult = FInventoryOperationResult::Fail(FString::Printf(TEXT("Slot %d has no valid item"), SlotIndex));
-		TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_QuickSlotUse, FailResult,
-			static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-			FString::Printf(TEXT("Slot %d no item"), SlotIndex));
-		return FailResult;
+		PredictionKey = ++LastPredictionKey;
+		ServerUseQuickSlot(SlotIndex, PredictionKey);
 	}
 
 	OnQuickSlotUsed.Broadcast(SlotIndex, Item);
@@ -154,10 +191,32 @@ FInventoryOperationResult UQuickAccessSlots::UseQuickSlot(int32 SlotIndex)
 	FInventoryOperationResult OkResult = FInventoryOperationResult::Ok();
 	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_QuickSlotUse, OkResult,
 		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
-		FString::Printf(TEXT("Slot:%d Item:%s"), SlotIndex, *Item->GetClass()->GetName()));
+		FString::Printf(TEXT("Slot:%d Item:%s Key:%d"), SlotIndex, *Item->GetClass()->GetName(), PredictionKey));
 	return OkResult;
 }
 
+void UQuickAccessSlots::ServerUseQuickSlot_Implementation(int32 SlotIndex, int32 PredictionKey)
+{
+	double StartTime = FPlatformTime::Seconds();
+
+	// Validation only: the owning client already fired OnQuickSlotUsed when it predicted the use
+	FInventoryOperationResult Result = ValidateQuickSlotUse(SlotIndex);
+	TrackInventoryOperation(GetWorld(), EInventoryOperationType::IOT_QuickSlotUse, Result,
+		static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0),
+		FString::Printf(TEXT("Server Slot:%d Key:%d"), SlotIndex, PredictionKey));
+
+	if (!Result.bSuccess)
+	{
+		ClientRejectQuickSlotUse(SlotIndex, PredictionKey, Result.Message);
+	}
+}
+
+void UQuickAccessSlots::ClientRejectQuickSlotUse_Implementation(int32 SlotIndex, int32 PredictionKey, const FString& Reason)
+{
+	UE_LOG(LogInventory, Log, TEXT("Predicted use of quick slot %d (key %d) rejected: %s"), SlotIndex, PredictionKey, *Reason);
+	OnQuickSlotUseRejected.Broadcast(SlotIndex, PredictionKey, Reason);
+}
+
 FInventoryOperationResult UQuickAccessSlots::SwapQuickSlots(int32 SlotIndexA, int32 SlotIndexB)
 {
 	double StartTime = FPlatformTime::Seconds();
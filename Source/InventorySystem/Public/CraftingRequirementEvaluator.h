@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CraftingRequirementEvaluator.generated.h"
+
+class UInventoryComponent;
+
+USTRUCT(BlueprintType)
+struct FCraftingIngredient
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crafting")
+	FString ItemID;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crafting", meta = (ClampMin = "1"))
+	int32 Quantity = 1;
+};
+
+USTRUCT(BlueprintType)
+struct FCraftingRecipe
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crafting")
+	FName RecipeID;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crafting")
+	TArray<FCraftingIngredient> Ingredients;
+};
+
+/**
+ * Tracks how many times each recipe in a set can be crafted from one inventory.
+ * Ingredient IDs are hashed once when recipes are set. Refresh reads each distinct ingredient's total from the
+ * inventory's cached per-item table and re-evaluates only the recipes that use an ingredient whose total changed.
+ */
+UCLASS(BlueprintType)
+class INVENTORYSYSTEM_API UCraftingRequirementEvaluator : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Replaces the recipe set. Every recipe is re-evaluated on the next Refresh.
+	 * @param InRecipes Recipes to track. Duplicate ingredients within a recipe are summed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Crafting")
+	void SetRecipes(const TArray<FCraftingRecipe>& InRecipes);
+
+	/** Sets the inventory to evaluate against. Every recipe is re-evaluated on the next Refresh. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Crafting")
+	void SetInventory(UInventoryComponent* InInventory);
+
+	/**
+	 * Brings craftable counts up to date with the inventory.
+	 * Does nothing if the inventory contents have not changed since the last call.
+	 * @return Number of recipes whose craftable count changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Crafting")
+	int32 Refresh();
+
+	/** Craftable counts, one per recipe in SetRecipes order. Valid as of the last Refresh. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Crafting")
+	TArray<int32> GetCraftableCounts() const { return CraftableCounts; }
+
+	/** Indices of the recipes whose craftable count changed during the last Refresh. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Crafting")
+	TArray<int32> GetChangedRecipes() const { return ChangedRecipes; }
+
+	/** Returns how many times a recipe can be crafted as of the last Refresh, or 0 for an unknown recipe. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Crafting")
+	int32 GetCraftableCount(FName RecipeID) const;
+
+	/** Number of recipes re-evaluated by the last Refresh. */
+	int32 GetLastEvaluatedCount() const { return LastEvaluatedCount; }
+
+private:
+	/** An ingredient as an index into IngredientKeys */
+	struct FCompiledIngredient
+	{
+		int32 KeyIndex;
+		int32 Quantity;
+	};
+
+	int32 EvaluateRecipe(int32 RecipeIndex) const;
+
+	UPROPERTY()
+	TArray<FCraftingRecipe> Recipes;
+
+	UPROPERTY()
+	TWeakObjectPtr<UInventoryComponent> Inventory;
+
+	/** Distinct ingredient item keys across all recipes */
+	TArray<uint64> IngredientKeys;
+
+	/** Inventory total of each ingredient key as of the last Refresh */
+	TArray<int32> IngredientTotals;
+
+	/** Ingredients of all recipes, flattened; recipe i owns [RecipeIngredientStart[i], RecipeIngredientStart[i + 1]) */
+	TArray<FCompiledIngredient> CompiledIngredients;
+	TArray<int32> RecipeIngredientStart;
+
+	/** Ingredient key index -> recipes that use it */
+	TArray<TArray<int32>> RecipesByKey;
+
+	TArray<int32> CraftableCounts;
+	TArray<int32> ChangedRecipes;
+	TMap<FName, int32> RecipeIndexByID;
+
+	/** FInventorySlotsGroup::GetContentVersion at the last Refresh */
+	uint64 EvaluatedContentVersion = 0;
+
+	bool bNeedsFullEvaluation = true;
+	int32 LastEvaluatedCount = 0;
+};
@@ -3,11 +3,20 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Struct/InventorySlotsGroup.h"
+#include "Struct/InventorySlotHandle.h"
 #include "Struct/InventoryOperationResult.h"
+#include "Struct/InventoryBatchResult.h"
+#include "Struct/InventoryChangeSet.h"
+#include "Struct/InventoryReplicatedSlots.h"
+#include "Struct/InventoryPrediction.h"
+#include "Struct/InventoryContainerSummary.h"
 #include "InventoryComponent.generated.h"
 
 class UItemBase;
 class UInventoryModuleBase;
+class UInventoryComponent;
+class UInventoryOnDemandSlots;
+class APlayerController;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemAdded, UItemBase*, Item, int32, GroupIndex, int32, SlotIndex);
 
@@ -16,8 +25,44 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemRemoved, UItemBase*, Item,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FOnItemStackChanged, UItemBase*, Item, int32, GroupIndex, int32,
                                               SlotIndex, int32, OldAmount, int32, NewAmount);
 
+/** FOnItemAdded with the slot's generation-checked handle. Fired right after OnItemAdded. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnItemAddedWithHandle, UItemBase*, Item, int32, GroupIndex, int32, SlotIndex,
+                                              const FInventorySlotHandle&, Handle);
+
+/** Handle is the slot's handle from before the removal; it stops resolving once the slot no longer holds Item. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnItemRemovedWithHandle, UItemBase*, Item, int32, GroupIndex, int32, SlotIndex,
+                                              const FInventorySlotHandle&, Handle);
+
+/** FOnItemStackChanged with the slot's generation-checked handle. Fired right after OnItemStackChanged. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_SixParams(FOnItemStackChangedWithHandle, UItemBase*, Item, int32, GroupIndex, int32,
+                                             SlotIndex, int32, OldAmount, int32, NewAmount,
+                                             const FInventorySlotHandle&, Handle);
+
+/** Fired once per AddItems call. Entries are in input order and include items that only partly fit. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemsAdded, const TArray<FInventoryBatchAddEntry>&, Entries);
+
+/** Fired once per committed FInventoryTransaction or bulk consume with every slot it wrote in this inventory. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSlotsChanged, const TArray<FInventorySlotHandle>&, ChangedSlots);
+
+/** Fired once per flush with every slot and item total that changed since the previous flush. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, const FInventoryChangeSet&, ChangeSet);
+
+/**
+ * Fired on both the source and the target of a TransferToInventory, once each.
+ * ChangedSlots are the slots written in the broadcasting component. Item is nullptr when a value stack moved.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FOnItemTransferred, UItemBase*, Item, UInventoryComponent*, Source,
+                                              UInventoryComponent*, Target, int32, Quantity,
+                                              const TArray<FInventorySlotHandle>&, ChangedSlots);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryFull, UItemBase*, Item, int32, RequiredSlots);
 
+/** Fired on the owning client when the server refused a predicted operation. Its slots roll back when the server's state replicates. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPredictionRejected, int32, PredictionKey, const FString&, Reason);
+
+/** Fired on the viewing inventory when it opens or closes a container, including when the server closes it. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnContainerSessionChanged, UInventoryComponent*, Container, bool, bOpen);
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class INVENTORYSYSTEM_API UInventoryComponent : public UActorComponent
 {
@@ -29,16 +74,18 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch,
 	                                 FReplicationFlags* RepFlags) override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 	                           FActorComponentTickFunction* ThisTickFunction) override;
 
 protected:
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", ReplicatedUsing = OnRep_InventorySlotsGroup)
 	FInventorySlotsGroup InventorySlotsGroup;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
@@ -47,19 +94,355 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Modules", Replicated)
 	TArray<TObjectPtr<UInventoryModuleBase>> InstalledModules;
 
+	/**
+	 * Every class that has appeared as a value stack in the slot mirrors, append-only.
+	 * Mirror entries send a value stack's class as an index into this table, so each class reference goes out once.
+	 * Declared ahead of the mirrors so it is received first when both change in one update.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_ValueItemClasses)
+	TArray<TSubclassOf<UItemBase>> ValueItemClasses;
+
+	/** Contents of IGR_Public groups, delta-replicated per slot. InventorySlotsGroup only replicates the group layout. */
+	UPROPERTY(Replicated)
+	FInventoryReplicatedSlotArray ReplicatedSlots;
+
+	/** Contents of IGR_OwnerOnly groups, replicated to the owning connection only. */
+	UPROPERTY(Replicated)
+	FInventoryReplicatedSlotArray OwnerReplicatedSlots;
+
+	/**
+	 * Contents of IGR_OnDemand groups. Null until the first on-demand group syncs on the server, and on clients
+	 * that are neither the owner nor have the inventory open.
+	 */
+	UPROPERTY(Replicated)
+	TObjectPtr<UInventoryOnDemandSlots> OnDemandSlots;
+
+	/** Replicated to every connection, so containers can be labelled without an open session. */
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory|Sessions")
+	FInventoryContainerSummary ContainerSummary;
+
+	/**
+	 * Furthest a viewer's pawn may be from the owning actor to open or keep open a session.
+	 * 0 disables the check, leaving CanOpenSession as the only gate.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory|Sessions", meta = (ClampMin = "0"))
+	float MaxSessionDistance = 500.0f;
+
+	/**
+	 * Accumulate changes and broadcast them as one OnInventoryChanged at the end of each frame instead of reacting per slot.
+	 * The per-slot events still fire either way.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory|Events")
+	bool bDeferChangeNotifications = false;
+
+	/**
+	 * Key of the last predicted request the server processed, replicated to the owner.
+	 * Sent in the same update as the slot changes it caused, so its OnRep sees the server's result in the slot mirrors.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_LastServerPredictionKey)
+	int32 LastServerPredictionKey = 0;
+
+	/** Replicated slot data bypasses the per-group lookup caches, so they are rebuilt on next access. */
+	UFUNCTION()
+	void OnRep_InventorySlotsGroup();
+
+	UFUNCTION()
+	void OnRep_LastServerPredictionKey();
+
+	/** Applies mirror entries whose value stack class arrived after them. */
+	UFUNCTION()
+	void OnRep_ValueItemClasses();
+
+	/** Runs a predicted request authoritatively and acknowledges its key. */
+	UFUNCTION(Server, Reliable)
+	void ServerExecutePredicted(const FInventoryPredictedRequest& Request);
+
+	/** Tells the owning client why a predicted request failed. The rollback itself arrives through replication. */
+	UFUNCTION(Client, Reliable)
+	void ClientRejectPrediction(int32 PredictionKey, const FString& Reason);
+
+	/** Opens a session on Container for this component's player. Sent through the viewer's own inventory, which it owns. */
+	UFUNCTION(Server, Reliable)
+	void ServerOpenContainer(UInventoryComponent* Container);
+
+	UFUNCTION(Server, Reliable)
+	void ServerCloseContainer(UInventoryComponent* Container);
+
+	/** Tells the viewer the server ended its session on Container, e.g. out of range or the open was refused. */
+	UFUNCTION(Client, Reliable)
+	void ClientContainerClosed(UInventoryComponent* Container, const FString& Reason);
+
+public:
+	/**
+	 * Writes a replicated slot into the local slot groups and fires the matching per-slot event. Clients only.
+	 * Ignored if the group layout has not arrived yet; OnRep_InventorySlotsGroup re-applies every entry.
+	 * Value stacks have no object, so changes to them fire OnSlotsChanged instead of the per-item events.
+	 * @param Item The slot's item, or nullptr if the slot was emptied or holds a value stack.
+	 * @param ValueItemClass The value stack's class, or nullptr.
+	 */
+	void ApplyReplicatedSlot(int32 GroupIndex, int32 SlotIndex, UItemBase* Item, TSubclassOf<UItemBase> ValueItemClass,
+	                         int32 Quantity, bool bBroadcast = true);
+
+	/** Index of a value stack class in ValueItemClasses, appending it if new. Server only. */
+	int32 FindOrAddValueItemClass(TSubclassOf<UItemBase> ItemClass);
+
+	/** The value stack class at an index, or nullptr if the table entry has not been received yet. */
+	TSubclassOf<UItemBase> ResolveValueItemClass(int32 ClassIndex) const
+	{
+		return ValueItemClasses.IsValidIndex(ClassIndex) ? ValueItemClasses[ClassIndex] : nullptr;
+	}
+
+	/** Bits sent (server) or received (client) through both slot mirrors since the last reset. */
+	FInventoryReplicationStats GetReplicationStats() const;
+
+	/** Replication work this component caused since the last reset. Server only; all zero on clients. */
+	FORCEINLINE const FInventoryNetMetrics& GetNetMetrics() const { return NetMetrics; }
+
+	/** Resets both the mirror bit counts and the net metrics. */
+	void ResetReplicationStats();
+
+	/**
+	 * Starts receiving Container's IGR_OnDemand groups and their items. Call on the viewer's own inventory.
+	 * Clients ask the server; the contents arrive through replication and show until CloseContainer.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sessions")
+	void OpenContainer(UInventoryComponent* Container);
+
+	/** Stops receiving Container's on-demand contents and clears the local copy of them. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sessions")
+	void CloseContainer(UInventoryComponent* Container);
+
+	/** True if this inventory opened Container and has not closed it since. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Sessions")
+	bool IsContainerOpen(const UInventoryComponent* Container) const;
+
+	UFUNCTION(BlueprintPure, Category = "Inventory|Sessions")
+	const FInventoryContainerSummary& GetContainerSummary() const { return ContainerSummary; }
+
+	/**
+	 * Adds a connection to the session net group, so it receives the on-demand groups. Server only.
+	 * @param Viewer The viewing player.
+	 * @param ViewerInventory The inventory the session was opened through; told if the session is closed from here.
+	 */
+	FInventoryOperationResult AddSession(APlayerController* Viewer, UInventoryComponent* ViewerInventory);
+
+	/**
+	 * Decides whether a player may open this inventory, e.g. for locked or team-owned containers.
+	 * AddSession checks it after the range check. Server only.
+	 * @param Viewer The player asking to open it.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Inventory|Sessions")
+	bool CanOpenSession(APlayerController* Viewer) const;
+	virtual bool CanOpenSession_Implementation(APlayerController* Viewer) const;
+
+	/** Removes a connection from the session net group. The owning connection stays a member. Server only. */
+	void RemoveSession(APlayerController* Viewer);
+
+	/** Connections with an open session, not counting the owner. Server only. */
+	int32 GetSessionCount() const { return Sessions.Num(); }
+
+	/** Net condition group of this inventory's on-demand mirror and items. */
+	FName GetSessionNetGroup() const;
+
+private:
+	/** Commit fires the per-item events for the slots it writes */
+	friend struct FInventoryTransaction;
+
+	/**
+	 * Copies every slot written since the last sync into ReplicatedSlots and marks the push-model properties
+	 * whose data changed. Returns immediately for an inventory that has not changed. Server only.
+	 */
+	void SyncReplicatedSlots();
+
+	/** The slot mirror a group's contents replicate through, by its replication policy. Creates OnDemandSlots if needed. */
+	FInventoryReplicatedSlotArray& GetSlotMirror(const FInventorySlots& Group);
+
+	/** The subobject condition a group's items register with, by its replication policy. */
+	static ELifetimeCondition GetReplicationCondition(const FInventorySlots& Group);
+
+	/** Visits ReplicatedSlots, OwnerReplicatedSlots and, if it exists, the on-demand mirror. */
+	void ForEachSlotMirror(TFunctionRef<void(FInventoryReplicatedSlotArray&)> Visitor);
+
+	/** Updates ContainerSummary from the slot groups, marking it dirty if it changed. Server only. */
+	void UpdateContainerSummary();
+
+	/**
+	 * Keeps the owning player in the session net group and closes sessions whose viewer left or moved out of range.
+	 * Runs each net update. Server only.
+	 */
+	void UpdateSessions();
+
+	/** The player controller this component's actor belongs to, found through the owner chain. */
+	APlayerController* GetOwningController() const;
+
+	/** True if Viewer's pawn is within MaxSessionDistance of the owning actor. */
+	bool IsInSessionRange(const APlayerController* Viewer) const;
+
+	/** Drops every session and the owner from the session net group, and unregisters the on-demand mirror. Server only. */
+	void EndSessions();
+
+	/** Empties every slot of the on-demand groups locally, firing the per-slot events. Clients only. */
+	void ClearOnDemandContents();
+
+	/** Re-applies the on-demand mirror as last received, ahead of the deltas a reopened session brings. Clients only. */
+	void ReapplyOnDemandContents();
+
+	/** A connection with an open session on this inventory. */
+	struct FContainerSession
+	{
+		TWeakObjectPtr<APlayerController> Viewer;
+		TWeakObjectPtr<UInventoryComponent> ViewerInventory;
+	};
+
+	/** Server only */
+	TArray<FContainerSession> Sessions;
+
+	/** Owning player currently in the session net group. Server only. */
+	TWeakObjectPtr<APlayerController> OwnerSessionViewer;
+
+	/** Containers this inventory has open, as the viewer */
+	TArray<TWeakObjectPtr<UInventoryComponent>> OpenContainers;
+
+	/** Set on clients while the local player has this container closed, so on-demand entries are not applied. */
+	bool bOnDemandContentsHidden = false;
+
+	mutable FName SessionNetGroup;
+
+	/** InventorySlotsGroup layout version last marked dirty and used to key the slot mirrors */
+	uint64 SyncedLayoutVersion = MAX_uint64;
+
+	/** InventorySlotsGroup content version last copied into the slot mirrors */
+	uint64 SyncedContentVersion = MAX_uint64;
+
+	FInventoryNetMetrics NetMetrics;
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void BindEndOfFrameFlush();
+	void UnbindEndOfFrameFlush();
+
+	/** Takes the current contents as the baseline for the next change set and discards pending slot changes. */
+	void ResetChangeTracking();
+
+	/** Fire the per-item event and its handle-carrying counterpart */
+	void BroadcastItemAdded(UItemBase* Item, int32 TypeID, int32 SlotIndex, const FInventorySlotHandle& Handle);
+	void BroadcastItemRemoved(UItemBase* Item, int32 TypeID, int32 SlotIndex, const FInventorySlotHandle& Handle);
+	void BroadcastItemStackChanged(UItemBase* Item, int32 TypeID, int32 SlotIndex, int32 OldAmount, int32 NewAmount,
+	                               const FInventorySlotHandle& Handle);
+
+	/** A predicted request applied locally and not yet acknowledged by the server. */
+	struct FPendingPrediction
+	{
+		FInventoryPredictedRequest Request;
+
+		/** (GroupIndex, SlotIndex) of every slot the prediction wrote */
+		TArray<TPair<int32, int32>, TInlineAllocator<2>> TouchedSlots;
+	};
+
+	/** True if this is an owning client that may apply slot operations before the server confirms them. */
+	bool CanPredict() const;
+
+	/**
+	 * Applies a request locally, queues it and sends it to the server. Owning clients only.
+	 * Requests that cannot be modelled exactly on the client (e.g. a transfer the server would re-route) are sent unpredicted.
+	 */
+	FInventoryOperationResult PredictOperation(FInventoryPredictedRequest Request);
+
+	/**
+	 * Writes a request's effect into the local slots without creating or changing any item object.
+	 * Splitting an object stack needs a new object that only the server can create, so that split is not predicted.
+	 * @return False if the request does not apply to the current local slots; nothing is written then.
+	 */
+	bool ApplyPredictedOperation(const FInventoryPredictedRequest& Request, FPendingPrediction& OutPending);
+
+	/** Runs a request authoritatively through the matching public operation. */
+	FInventoryOperationResult ExecuteRequest(const FInventoryPredictedRequest& Request);
+
+	/**
+	 * Drops predictions the server has processed, restores every predicted slot from the replicated mirrors,
+	 * then re-applies the predictions still in flight.
+	 * @param bLayoutChanged The groups were just refilled from the mirrors after a layout change, so every predicted
+	 *                       write is already rolled back. In-flight predictions that no longer apply are rejected locally.
+	 */
+	void ReconcilePredictions(int32 AckedKey, bool bLayoutChanged = false);
+
+	/** Rebuilds PredictedSlots from PendingPredictions. */
+	void RebuildPredictedSlots();
+
+	/** Predictions in send order */
+	TArray<FPendingPrediction> PendingPredictions;
+
+	/** (GroupIndex, SlotIndex) -> number of pending predictions touching it. Replicated writes to these slots wait for the ack. */
+	TMap<TPair<int32, int32>, int32> PredictedSlots;
+
+	/** Last key handed out on this client */
+	int32 LastPredictionKey = 0;
+
+	/** Keys already rejected locally after a layout change, so the server's own rejection is not broadcast twice */
+	TSet<int32> LocallyRejectedPredictionKeys;
+
+	FDelegateHandle PostActorTickHandle;
+
+	/** Item totals as of the last flush, keyed by FItemDefinition::GetItemKey */
+	TMap<uint64, int32> FlushedItemTotals;
+
+	/** Item key -> ItemID for every item seen, so deltas can name items that have left the inventory */
+	TMap<uint64, FString> KnownItemIDs;
+
+	uint64 FlushedContentVersion = 0;
+
 public:
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
 	FOnItemAdded OnItemAdded;
 
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnItemsAdded OnItemsAdded;
+
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
 	FOnItemRemoved OnItemRemoved;
 
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
 	FOnItemStackChanged OnItemStackChanged;
 
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnItemAddedWithHandle OnItemAddedWithHandle;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnItemRemovedWithHandle OnItemRemovedWithHandle;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnItemStackChangedWithHandle OnItemStackChangedWithHandle;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnSlotsChanged OnSlotsChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnItemTransferred OnItemTransferred;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnContainerSessionChanged OnContainerSessionChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnInventoryChanged OnInventoryChanged;
+
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
 	FOnInventoryFull OnInventoryFull;
 
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Events")
+	FOnPredictionRejected OnPredictionRejected;
+
+	/** Switches deferred change notifications on or off. Switching on starts from the current contents. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Events")
+	void SetDeferChangeNotifications(bool bDefer);
+
+	/**
+	 * Broadcasts OnInventoryChanged with everything that changed since the previous flush.
+	 * Called automatically at the end of each frame while bDeferChangeNotifications is set.
+	 * @return True if there was anything to broadcast.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Events")
+	bool FlushChangeSet();
+
 public:
 	/**
 	 * Attempts to add an item to a specific slot group, or any compatible group if TargetTypeID is -1.
@@ -69,28 +452,136 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FInventoryOperationResult AddItem(UItemBase* Item, int32 TargetTypeID = -1);
 
+	/**
+	 * Adds a batch of items with one authority check, one OnItemsAdded broadcast and one tracker entry.
+	 * OnItemAdded is not fired for batched items.
+	 * @param Items Items to add, in priority order.
+	 * @param TargetTypeID Target slot group type ID. Pass -1 to auto-select compatible groups.
+	 * @return One entry per input item, including partial overflow.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	TArray<FInventoryBatchAddEntry> AddItems(const TArray<UItemBase*>& Items, int32 TargetTypeID = -1);
+
+	TArray<FInventoryBatchAddEntry> AddItems(TArrayView<UItemBase* const> Items, int32 TargetTypeID = -1);
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FInventoryOperationResult RemoveItem(UItemBase* Item);
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FInventoryOperationResult RemoveItemAt(int32 TypeID, int32 SlotIndex, int32 Quantity = 1);
 
+	/** Returns the slot's item object, or nullptr if the slot is empty or holds a value stack. Use MaterializeSlot to get an object for a value stack. */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	UItemBase* GetItemAtIndex(int32 SlotTypeID, int32 SlotIndex) const;
 
+	/** Returns the class of whatever the slot holds, object or value stack, without materializing anything. */
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	TSubclassOf<UItemBase> GetItemClassAtIndex(int32 SlotTypeID, int32 SlotIndex) const;
+
+	/**
+	 * Replaces a value stack with a pooled item object holding the same units. Server only.
+	 * The slot keeps its generation, so handles to it stay valid.
+	 * @param GroupIndex Index into the group array, as in FInventorySlotHandle.
+	 * @return The slot's item object, or nullptr if the slot is empty or this is not the server.
+	 */
+	UItemBase* MaterializeSlot(int32 GroupIndex, int32 SlotIndex);
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool FindItemLocation(UItemBase* Item, int32& OutTypeID, int32& OutSlotIndex) const;
 
+	/**
+	 * Moves a slot's contents to another slot of this inventory.
+	 * On the owning client the move is applied at once under a prediction key and confirmed or rolled back by the server.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FInventoryOperationResult TransferItem(int32 FromTypeID, int32 FromIndex, int32 ToTypeID, int32 ToIndex);
 
+	/** Exchanges two slots of one group. Predicted on the owning client, like TransferItem. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	FInventoryOperationResult SwapSlots(int32 TypeID, int32 IndexA, int32 IndexB);
+
+	/**
+	 * Moves Amount units of a stack into an empty slot of the same group. Predicted on the owning client, like TransferItem.
+	 * @param Amount Units to split off. Must leave at least one unit behind.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	FInventoryOperationResult SplitStack(int32 TypeID, int32 SourceIndex, int32 TargetIndex, int32 Amount);
+
+	/** Key of the most recent predicted operation on this client, to match against OnPredictionRejected. 0 if none. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Prediction")
+	int32 GetLastPredictionKey() const { return LastPredictionKey; }
+
+	/** True while any predicted operation waits for the server. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Prediction")
+	bool HasPendingPredictions() const { return PendingPredictions.Num() > 0; }
+
+	/**
+	 * Moves units from one of this inventory's slots straight into another inventory, topping up its partial stacks first.
+	 * The item object is re-outered at most once and never passes through the item pool.
+	 * Fires OnItemTransferred on both components, after the per-item removed/added/stack-changed events for item objects.
+	 * All-or-nothing: fails without changes if the units do not all fit, or if part of a stack would need a new slot.
+	 * @param Target Inventory to move into.
+	 * @param Handle Source slot in this inventory.
+	 * @param Quantity Units to move. Pass -1 for the whole stack.
+	 * @param TargetTypeID Target slot group type ID. Pass -1 to auto-select compatible groups.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	FInventoryOperationResult TransferToInventory(UInventoryComponent* Target, const FInventorySlotHandle& Handle,
+	                                              int32 Quantity = -1, int32 TargetTypeID = -1);
+
+	/** Returns a generation-checked handle to the slot holding Item, or an unset handle if it is not in this inventory. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Handles")
+	FInventorySlotHandle FindItemHandle(UItemBase* Item) const;
+
+	/** Returns a handle to a slot addressed by TypeID and slot index. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Handles")
+	FInventorySlotHandle MakeSlotHandle(int32 TypeID, int32 SlotIndex) const;
+
+	/** Returns true if the handle's slot still holds the item object it was made for. */
+	UFUNCTION(BlueprintPure, Category = "Inventory|Handles")
+	bool IsSlotHandleValid(const FInventorySlotHandle& Handle) const;
+
+	/** Returns the item object in the handle's slot, or nullptr if the handle is stale or the slot holds a value stack. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Handles")
+	UItemBase* GetItemByHandle(const FInventorySlotHandle& Handle) const;
+
+	/**
+	 * Translates a valid handle into the TypeID and slot index used by the rest of this API.
+	 * @return False if the handle is stale.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Handles")
+	bool ResolveSlotHandle(const FInventorySlotHandle& Handle, int32& OutTypeID, int32& OutSlotIndex) const;
+
 	/**
 	 * Returns true if the item can be added to the inventory.
+	 * Only checks for room for part of the stack; use PlanAdd(...).FitsCompletely() to check the whole quantity.
 	 * @param SlotTypeID Restrict check to a specific slot group. Pass -1 to check all groups.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool CanAddItem(UItemBase* Item, int32 SlotTypeID = -1) const;
 
+	/**
+	 * Simulates AddItem against the current stacks without changing anything.
+	 * @param Item Item to plan for.
+	 * @param Quantity Units to place. Pass -1 to use the item's current stack size.
+	 * @param TargetTypeID Target slot group type ID. Pass -1 to auto-select compatible groups.
+	 * @return How many units fit and which slots they would go to.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Planning")
+	FInventoryAddPlan PlanAdd(UItemBase* Item, int32 Quantity = -1, int32 TargetTypeID = -1) const;
+
+	/** PlanAdd for an item that does not exist yet, as AddItemByClass would create it. Reads the class defaults. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Planning")
+	FInventoryAddPlan PlanAddByClass(TSubclassOf<UItemBase> ItemClass, int32 Quantity = 1, int32 TargetTypeID = -1) const;
+
+	/**
+	 * Plans a whole bundle in order; each item sees the slots planned for the items before it.
+	 * @param OutPlans Receives one plan per item, in input order.
+	 * @return True if every item fits completely.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Planning")
+	bool PlanAddBatch(const TArray<UItemBase*>& Items, TArray<FInventoryAddPlan>& OutPlans, int32 TargetTypeID = -1) const;
+
 	/**
 	 * Returns the number of empty slots. Pass -1 to count across all groups.
 	 */
@@ -101,6 +592,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	int32 GetItemCount(UItemBase* Item, int32 SlotTypeID = -1) const;
 
+	/** Returns every item object. Value stacks have no object and are skipped; iterate the slots to see them. */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<UItemBase*> GetAllItems() const;
 
@@ -120,6 +612,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Stacking")
 	FInventoryOperationResult TryStackItem(UItemBase* Item, int32 SlotTypeID = -1);
 
+	/**
+	 * Removes exactly Quantity units of an item, draining the smallest stacks first.
+	 * Fires one OnSlotsChanged instead of OnItemRemoved per slot. Fails without removing anything if too few units are held.
+	 * @param ItemID The item's definition ID.
+	 * @param Quantity Units to remove.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Consume")
+	FInventoryOperationResult ConsumeItems(const FString& ItemID, int32 Quantity);
+
+	/**
+	 * Removes several ingredients at once. All-or-nothing: if any ingredient is short, nothing is removed.
+	 * @param Ingredients Item definition ID to quantity.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Consume")
+	FInventoryOperationResult ConsumeItemSet(const TMap<FString, int32>& Ingredients);
+
+	/** ConsumeItemSet with pre-hashed item keys (FItemDefinition::GetItemKey). */
+	FInventoryOperationResult ConsumeItemKeys(TArrayView<const TPair<uint64, int32>> Requests);
+
+	/**
+	 * Adds units of a class. Classes that support value stacks (UItemBase::SupportsValueStacks) are stored as
+	 * a class and a count with no object, fire OnSlotsChanged and are all-or-nothing. Other classes go through AddItem.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FInventoryOperationResult AddItemByClass(TSubclassOf<UItemBase> ItemClass, int32 Quantity = 1, int32 SlotTypeID = -1);
 
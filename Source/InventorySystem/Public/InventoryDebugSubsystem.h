@@ -63,6 +63,58 @@ struct FInventoryDebugStats
 
 	UPROPERTY(BlueprintReadOnly, Category = "Debug")
 	int32 PooledItemsActive = 0;
+
+	/** Slot mirror delta updates sent (server) or received (client) */
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 NetUpdates = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	float NetAverageBytesPerUpdate = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 NetLastUpdateBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 NetPeakUpdateBytes = 0;
+};
+
+/** Replication cost of one inventory component, as reported by GetNetCostReport. */
+USTRUCT(BlueprintType)
+struct FInventoryNetCostEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UInventoryComponent> Inventory;
+
+	/** Owner and component name */
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	FString Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int64 TotalBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 MirrorUpdates = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	float AverageBytesPerUpdate = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 NetUpdates = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 PropertiesMarkedDirty = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 SubobjectsRegistered = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	int32 SubobjectsWritten = 0;
+
+	/** Time in PreReplication and ReplicateSubobjects combined */
+	UPROPERTY(BlueprintReadOnly, Category = "Debug")
+	float ReplicationMs = 0.0f;
 };
 
 /**
@@ -141,7 +193,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Profiling")
 	float BenchmarkAddItem(UInventoryComponent* Inventory, int32 Iterations = 1000);
 
-	/** Runs item searches in a tight loop and returns average duration in milliseconds. */
+	/** Times indexed item lookups against a linear slot scan, logs the speedup and returns the indexed average in milliseconds. */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Profiling")
 	float BenchmarkSearch(UInventoryComponent* Inventory, int32 Iterations = 100);
 
@@ -163,6 +215,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Testing")
 	void TestNetworkReplication(UInventoryComponent* Inventory);
 
+	/** Adds a component to the net cost report. Components register themselves on BeginPlay. */
+	void RegisterInventory(UInventoryComponent* Inventory);
+
+	void UnregisterInventory(UInventoryComponent* Inventory);
+
+	/**
+	 * Replication cost of every registered inventory, most bytes first.
+	 * @param Count How many to return; 0 or less returns all.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Network")
+	TArray<FInventoryNetCostEntry> GetNetCostReport(int32 Count = 10);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Network")
+	FString GetNetCostSummary(int32 Count = 10);
+
+	/** Resets the replication counters of every registered inventory. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Network")
+	void ResetNetCostStats();
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Debug|Tracking")
 	void RecordOperation(EInventoryOperationType Type, const FInventoryOperationResult& Result,
 	                     float DurationMs, const FString& Context = TEXT(""));
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Items/ItemBase.h"
 #include "Struct/InventorySlot.h"
+#include "Struct/InventorySlotHandle.h"
 #include "InventoryDragDropValidation.generated.h"
 
 class UInventoryComponent;
@@ -37,6 +38,14 @@ struct FDragDropContext
 	UPROPERTY(BlueprintReadOnly, Category = "Drag Drop")
 	int32 TargetSlotIndex = -1;
 
+	/** Optional. When set, takes precedence over SourceGroupIndex/SourceSlotIndex and rejects the drop if the source slot changed mid-drag. */
+	UPROPERTY(BlueprintReadWrite, Category = "Drag Drop")
+	FInventorySlotHandle SourceHandle;
+
+	/** Optional. When set, takes precedence over TargetGroupIndex/TargetSlotIndex and rejects the drop if the target slot changed mid-drag. */
+	UPROPERTY(BlueprintReadWrite, Category = "Drag Drop")
+	FInventorySlotHandle TargetHandle;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Drag Drop")
 	EDragDropOperationType OperationType = EDragDropOperationType::DDOT_Move;
 
@@ -147,8 +156,16 @@ public:
 
 protected:
 	static bool IsTargetSlotCompatible(const FDragDropContext& Context);
-	static bool CanItemsStack(UItemBase* ItemA, UItemBase* ItemB);
+	static bool CanItemsStack(const UItemBase* ItemA, const UItemBase* ItemB);
 	static const FInventorySlot* GetTargetSlot(const FDragDropContext& Context);
+	static const FInventorySlots* GetTargetGroup(const FDragDropContext& Context);
+
+	/**
+	 * Resolves one side of the drop to TypeID/slot addressing, preferring the handle when it is set.
+	 * @return False if the handle is set but stale.
+	 */
+	static bool ResolveContextSlot(const UInventoryComponent* Inventory, const FInventorySlotHandle& Handle,
+	                               int32 GroupTypeID, int32 SlotIndex, int32& OutTypeID, int32& OutSlotIndex);
 	static FDragDropValidationResult RunCustomValidators(const FDragDropContext& Context);
 
 	static TArray<FDragDropValidator> CustomValidators;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Struct/InventoryReplicatedSlots.h"
+#include "InventoryOnDemandSlots.generated.h"
+
+/**
+ * Slot mirror for an inventory's IGR_OnDemand groups, held in its own subobject so it can be filtered per connection.
+ * The owning component registers it with COND_NetGroup in its session net group: only the owning connection and
+ * connections with an open session receive it. Created on the server the first time an on-demand group syncs.
+ */
+UCLASS()
+class INVENTORYSYSTEM_API UInventoryOnDemandSlots : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostInitProperties() override;
+	virtual bool IsSupportedForNetworking() const override { return true; }
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UPROPERTY(Replicated)
+	FInventoryReplicatedSlotArray Slots;
+};
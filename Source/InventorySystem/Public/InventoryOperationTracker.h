@@ -26,6 +26,11 @@ enum class EInventoryOperationType : uint8
 	IOT_MergeItem UMETA(DisplayName = "Merge Item"),
 	IOT_AddItemModule UMETA(DisplayName = "Add Item Module"),
 	IOT_RemoveItemModule UMETA(DisplayName = "Remove Item Module"),
+	IOT_Transaction UMETA(DisplayName = "Transaction"),
+	IOT_ConsumeItems UMETA(DisplayName = "Consume Items"),
+	IOT_TransferToInventory UMETA(DisplayName = "Transfer To Inventory"),
+	IOT_OpenContainer UMETA(DisplayName = "Open Container"),
+	IOT_CloseContainer UMETA(DisplayName = "Close Container"),
 	IOT_Other UMETA(DisplayName = "Other")
 };
 
@@ -78,6 +78,9 @@ public:
 	static TArray<UItemBase*> FilterStackable(const TArray<UItemBase*>& Items);
 
 	static bool MatchesCriteria(const UItemBase* Item, const FInventoryFilterCriteria& Criteria);
+
+	/** Variant taking the criteria's TypeIDs pre-built as a mask, so loops build it once. */
+	static bool MatchesCriteria(const UItemBase* Item, const FInventoryFilterCriteria& Criteria, const FInventoryTypeMask& TypeMask);
 	static float CalculateRelevanceScore(const UItemBase* Item, const FString& SearchText);
 
 	/** Returns true if Pattern can be found in Source within a Levenshtein distance threshold. */
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Struct/InventoryOperationResult.h"
+
+class UInventoryComponent;
+class UItemBase;
+struct FInventorySlot;
+
+/**
+ * Stages slot mutations across one or more inventory components and applies them all at once.
+ *
+ * Every Stage call validates against the staged view of the slots, so later steps see the effect of earlier ones.
+ * Nothing touches the inventories until Commit, which re-checks that no staged slot changed underneath the journal,
+ * then writes every slot, broadcasts OnSlotsChanged once per touched component (OnItemRemoved for item objects that
+ * left it, OnItemsAdded for items that entered it) and records one tracker entry.
+ * Item objects whose units all left or merged into other stacks go back to the item pool.
+ * Rollback (or letting the transaction go out of scope) discards the journal without side effects.
+ *
+ * The first failing Stage call poisons the transaction; Commit then fails with that error.
+ */
+struct INVENTORYSYSTEM_API FInventoryTransaction
+{
+	FInventoryTransaction() = default;
+
+	/**
+	 * Stages removal of units from a slot.
+	 * @param Inventory Inventory holding the slot.
+	 * @param TypeID Group TypeID.
+	 * @param SlotIndex Slot to remove from.
+	 * @param Quantity Units to remove. Pass -1 for the whole stack.
+	 * @return False if the removal is invalid against the staged view.
+	 */
+	bool StageRemove(UInventoryComponent* Inventory, int32 TypeID, int32 SlotIndex, int32 Quantity = -1);
+
+	/**
+	 * Stages a move of units between two slots, possibly in different inventories.
+	 * A whole stack may go to an empty slot; any amount may merge into a stack of the same item with room.
+	 * @param ToTypeID Destination group. With ToSlotIndex INDEX_NONE, -1 means any compatible group.
+	 * @param ToSlotIndex Destination slot, or INDEX_NONE to top up partial stacks and then use the first free slot of the group.
+	 * @param Quantity Units to move. Pass -1 for the whole stack.
+	 * @return False if the move is invalid against the staged view.
+	 */
+	bool StageMove(UInventoryComponent* From, int32 FromTypeID, int32 FromSlotIndex,
+	               UInventoryComponent* To, int32 ToTypeID, int32 ToSlotIndex, int32 Quantity = -1);
+
+	/**
+	 * Stages adding an item that is not in any inventory yet.
+	 * @param TargetTypeID Group to place into, or -1 for the first compatible group with room.
+	 * @return False if the whole stack does not fit in the staged view.
+	 */
+	bool StageAdd(UInventoryComponent* Inventory, UItemBase* Item, int32 TargetTypeID = -1);
+
+	/**
+	 * Applies every staged mutation. Fails without side effects if a Stage call failed or a staged slot changed since it was read.
+	 * The journal is cleared either way.
+	 */
+	FInventoryOperationResult Commit();
+
+	/** Discards the journal. Nothing was applied, so there is nothing to undo. */
+	void Rollback();
+
+	FORCEINLINE bool IsEmpty() const { return Journal.Num() == 0 && !bFailed; }
+	FORCEINLINE bool HasFailed() const { return bFailed; }
+	FORCEINLINE const FString& GetError() const { return Error; }
+
+private:
+	/**
+	 * One staged slot: what it held when first read, and what it will hold after commit.
+	 * A value stack is journaled as its class defaults and a count, so staging never creates item objects.
+	 */
+	struct FJournalEntry
+	{
+		UInventoryComponent* Inventory = nullptr;
+		int32 GroupIndex = INDEX_NONE;
+		int32 SlotIndex = INDEX_NONE;
+
+		UItemBase* OriginalItem = nullptr;
+		int32 OriginalQuantity = 0;
+		int32 OriginalGeneration = 0;
+
+		UItemBase* Item = nullptr;
+		int32 Quantity = 0;
+		int32 MaxStack = 1;
+
+		FORCEINLINE bool IsEmpty() const { return Item == nullptr || Quantity <= 0; }
+		FORCEINLINE int32 GetRoom() const { return IsEmpty() ? 0 : MaxStack - Quantity; }
+		FORCEINLINE bool IsDirty() const { return Item != OriginalItem || Quantity != OriginalQuantity; }
+		bool IsValueStack() const;
+	};
+
+	/** What the journal records for a slot: its item object, the class defaults for a value stack, or nullptr if empty. */
+	static UItemBase* GetJournalItem(const FInventorySlot& Slot);
+
+	/** Returns the journal index for a slot, reading it from the inventory on first touch. INDEX_NONE if the slot does not exist. */
+	int32 TouchSlot(UInventoryComponent* Inventory, int32 GroupIndex, int32 SlotIndex);
+
+	int32 ResolveGroupIndex(const UInventoryComponent* Inventory, int32 TypeID) const;
+
+	/**
+	 * Places Quantity units of Item into a group using partial stacks first, then a free slot if the item object is not staged in one yet.
+	 * Class defaults stand for a value stack, which may start any number of free slots.
+	 * @param SkipEntry Journal entry to leave alone, e.g. the slot the units are being taken from.
+	 * @return Units that did not fit.
+	 */
+	int32 StagePlace(UInventoryComponent* Inventory, int32 GroupIndex, UItemBase* Item, int32 Quantity,
+	                 int32 SkipEntry = INDEX_NONE);
+
+	/** True if a journaled slot will hold the item object after commit. */
+	bool IsItemStaged(const UItemBase* Item) const;
+
+	bool Fail(const FString& Reason);
+
+	TArray<FJournalEntry> Journal;
+
+	/** (Inventory, GroupIndex, SlotIndex) -> Journal index */
+	TMap<TTuple<const UInventoryComponent*, int32, int32>, int32> JournalLookup;
+
+	FString Error;
+	bool bFailed = false;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "UObject/CoreNetTypes.h"
 #include "Modules/ItemModuleBase.h"
 #include "Struct/ItemDefinition.h"
 #include "Struct/InventoryOperationResult.h"
@@ -9,6 +10,7 @@
 #include "ItemBase.generated.h"
 
 class UTexture2D;
+class UActorComponent;
 class UInventoryComponent;
 
 /**
@@ -29,6 +31,10 @@ public:
 
 	virtual UWorld* GetWorld() const override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UFUNCTION(BlueprintCallable, Category = "Item|Save")
 	virtual FItemSaveData SaveToStruct(bool bCompress = false);
 
@@ -42,6 +48,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Item|Capabilities")
 	bool IsStackable() const { return bIsStackable; }
 
+	/**
+	 * True if units of this class can live in a slot as a plain count with no item object.
+	 * Only stackables with no modules qualify, since every unit is then interchangeable with the class defaults.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Item|Capabilities")
+	bool SupportsValueStacks() const
+	{
+		return bIsStackable && ItemModules.Num() == 0 && !ItemDefinition.GetItemID().IsEmpty();
+	}
+
 	UFUNCTION(BlueprintPure, Category = "Item|Stacking")
 	int32 GetCurrentStackSize() const { return CurrentStackSize; }
 
@@ -73,6 +89,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Item|State")
 	bool IsInInventory() const { return bIsInInventory; }
 
+	/**
+	 * Adds this item and its modules to a component's registered subobject list.
+	 * Modules added or removed afterwards are registered with the same component and condition until it unregisters the item.
+	 * Moves the registration if the item was registered with another component or condition.
+	 * @param Condition Which connections receive the item, matching its slot group's replication policy.
+	 * @param NetGroup With COND_NetGroup, the net condition group whose members receive the item and its modules.
+	 */
+	void RegisterReplicatedSubObjects(UActorComponent* Component, ELifetimeCondition Condition = COND_None,
+	                                  FName NetGroup = NAME_None);
+
+	/** Removes this item and its modules from a component's registered subobject list. */
+	void UnregisterReplicatedSubObjects(UActorComponent* Component);
+
 	UFUNCTION(BlueprintPure, Category = "Item|State")
 	AActor* GetOwner() const { return OwnerActor; }
 
@@ -148,9 +177,12 @@ public:
 	FString GetDebugString() const;
 
 protected:
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item|Data", meta = (AllowPrivateAccess = "true"))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item|Data", ReplicatedUsing = OnRep_ItemDefinition, meta = (AllowPrivateAccess = "true"))
 	FItemDefinition ItemDefinition;
 
+	UFUNCTION()
+	void OnRep_ItemDefinition();
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item|Stacking")
 	bool bIsStackable;
 
@@ -175,6 +207,15 @@ protected:
 
 	mutable TMap<UClass*, UItemModuleBase*> ModuleCache;
 
+	/** Component whose registered subobject list holds this item. Server only. */
+	TWeakObjectPtr<UActorComponent> ReplicationComponent;
+	ELifetimeCondition ReplicationCondition = COND_None;
+	FName ReplicationNetGroup;
+
+	/** Adds one of this item's subobjects to Component's list under the current condition and net group. */
+	void AddReplicatedSubObject(UActorComponent* Component, UObject* SubObject) const;
+	void RemoveReplicatedSubObject(UActorComponent* Component, UObject* SubObject) const;
+
 	FString GenerateUniqueItemID() const;
 	void CopyDefinitionTo(UItemBase* TargetItem) const;
 
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Items/ItemBase.h"
+#include "Struct/InventorySlotHandle.h"
+#include "Struct/InventoryBatchResult.h"
 #include "InventoryModuleBase.generated.h"
 
 class UInventoryComponent;
@@ -65,6 +67,15 @@ public:
 	{
 	}
 
+	/**
+	 * Reaction to a batch of items being added to the parent inventory.
+	 * The default implementation forwards every placed entry to OnItemAdded.
+	 * @param Entries Per-item outcome of the batch, in input order.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Module|Inventory Events")
+	void OnItemsAdded(const TArray<FInventoryBatchAddEntry>& Entries);
+	virtual void OnItemsAdded_Implementation(const TArray<FInventoryBatchAddEntry>& Entries);
+
 	/**
 	 * Reaction to an item being removed from the parent inventory.
 	 * @param Item The item instance removed.
@@ -62,6 +62,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Item Pool")
 	void ReturnItemToPool(UItemBase* Item);
 
+	/**
+	 * Return several items to their pools, resolving each class's pool once
+	 * @param Items Items to return to pool
+	 */
+	void ReturnItemsToPool(TArrayView<UItemBase* const> Items);
+
 	/**
 	 * Prewarm a pool for a specific item class
 	 * @param ItemClass Class to prewarm
@@ -128,4 +134,9 @@ protected:
 	 * Reset an item to default state before returning to pool
 	 */
 	void ResetItem(UItemBase* Item);
+
+	/**
+	 * Store an item that was already removed from the pool's active list
+	 */
+	void StoreReturnedItem(FItemPool& Pool, UItemBase* Item);
 };
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include "Components/ActorComponent.h"
 #include "Items/ItemBase.h"
 #include "Struct/InventoryOperationResult.h"
+#include "Struct/InventorySlotHandle.h"
 #include "QuickAccessSlots.generated.h"
 
+class UInventoryComponent;
+
 USTRUCT(BlueprintType)
 struct FQuickSlot
 {
@@ -14,11 +17,9 @@ struct FQuickSlot
 	UPROPERTY(BlueprintReadOnly, Category = "Quick Slot")
 	TObjectPtr<UItemBase> Item = nullptr;
 
+	/** Inventory slot the item was assigned from. May go stale; see UQuickAccessSlots::ResolveQuickSlotSource. */
 	UPROPERTY(BlueprintReadOnly, Category = "Quick Slot")
-	int32 SourceGroupIndex = -1;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Quick Slot")
-	int32 SourceSlotIndex = -1;
+	FInventorySlotHandle SourceHandle;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quick Slot")
 	FName KeyBinding = NAME_None;
@@ -29,8 +30,7 @@ struct FQuickSlot
 	void Clear()
 	{
 		Item = nullptr;
-		SourceGroupIndex = -1;
-		SourceSlotIndex = -1;
+		SourceHandle.Reset();
 	}
 
 	bool IsValid() const
@@ -42,6 +42,10 @@ struct FQuickSlot
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQuickSlotChanged, int32, SlotIndex, UItemBase*, Item);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQuickSlotUsed, int32, SlotIndex, UItemBase*, Item);
 
+/** Fired on the owning client when the server refused a use that OnQuickSlotUsed already announced locally. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnQuickSlotUseRejected, int32, SlotIndex, int32, PredictionKey,
+                                               const FString&, Reason);
+
 /** Hotbar component that provides quick access to inventory items by slot index or key binding. */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class INVENTORYSYSTEM_API UQuickAccessSlots : public UActorComponent
@@ -77,9 +81,22 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Quick Slots|Events")
 	FOnQuickSlotUsed OnQuickSlotUsed;
 
+	UPROPERTY(BlueprintAssignable, Category = "Quick Slots|Events")
+	FOnQuickSlotUseRejected OnQuickSlotUseRejected;
+
 public:
+	UFUNCTION(BlueprintCallable, Category = "Quick Slots", meta = (AutoCreateRefTerm = "SourceHandle"))
+	FInventoryOperationResult AssignToQuickSlot(int32 SlotIndex, UItemBase* Item, const FInventorySlotHandle& SourceHandle);
+
+	/**
+	 * Returns a valid handle to the inventory slot holding the quick slot's item.
+	 * A stale handle (e.g. after sorting) is re-resolved through the inventory's item index and stored back.
+	 * @param SlotIndex Quick slot index.
+	 * @param Inventory Inventory the item lives in.
+	 * @return Handle to the item's slot, or an unset handle if the item is no longer in Inventory.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Quick Slots")
-	FInventoryOperationResult AssignToQuickSlot(int32 SlotIndex, UItemBase* Item, int32 SourceGroupIndex = -1, int32 SourceSlotIndex = -1);
+	FInventorySlotHandle ResolveQuickSlotSource(int32 SlotIndex, UInventoryComponent* Inventory);
 
 	UFUNCTION(BlueprintCallable, Category = "Quick Slots")
 	FInventoryOperationResult ClearQuickSlot(int32 SlotIndex);
@@ -90,6 +107,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Quick Slots")
 	FQuickSlot GetQuickSlot(int32 SlotIndex) const;
 
+	/**
+	 * Fires OnQuickSlotUsed for the slot's item.
+	 * On the owning client the event fires at once under a prediction key and the server validates the use;
+	 * OnQuickSlotUseRejected fires if the server refuses it. The server does not fire OnQuickSlotUsed for it again.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Quick Slots")
 	FInventoryOperationResult UseQuickSlot(int32 SlotIndex);
 
@@ -119,6 +141,18 @@ public:
 protected:
 	bool IsValidSlotIndex(int32 SlotIndex) const;
 
+	/** Checks that the slot can be used, without firing any event. Shared by the local use and the server's validation. */
+	FInventoryOperationResult ValidateQuickSlotUse(int32 SlotIndex) const;
+
+	UFUNCTION(Server, Reliable)
+	void ServerUseQuickSlot(int32 SlotIndex, int32 PredictionKey);
+
+	UFUNCTION(Client, Reliable)
+	void ClientRejectQuickSlotUse(int32 SlotIndex, int32 PredictionKey, const FString& Reason);
+
+	/** Last prediction key handed out on this client */
+	int32 LastPredictionKey = 0;
+
 	UFUNCTION()
 	void OnItemRemovedFromInventory(UItemBase* Item);
 };
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryAddPlan.generated.h"
+
+/** One stack an add would write to. */
+USTRUCT(BlueprintType)
+struct FInventoryPlannedPlacement
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 TypeID = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 Quantity = 0;
+
+	/** True if the item object itself would occupy this (currently empty) slot */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	bool bNewStack = false;
+
+	FInventoryPlannedPlacement() = default;
+
+	FInventoryPlannedPlacement(int32 InTypeID, int32 InSlotIndex, int32 InQuantity, bool bInNewStack)
+		: TypeID(InTypeID), SlotIndex(InSlotIndex), Quantity(InQuantity), bNewStack(bInNewStack)
+	{
+	}
+};
+
+/** Result of simulating an add without touching any slot. */
+USTRUCT(BlueprintType)
+struct FInventoryAddPlan
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 RequestedQuantity = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 FitQuantity = 0;
+
+	/** Placements in the order AddItem would make them */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FInventoryPlannedPlacement> Placements;
+
+	FORCEINLINE bool FitsCompletely() const
+	{
+		return RequestedQuantity > 0 && FitQuantity == RequestedQuantity;
+	}
+
+	FORCEINLINE int32 GetOverflow() const
+	{
+		return RequestedQuantity - FitQuantity;
+	}
+};
+
+/**
+ * Units a plan has already assigned to slots, so later plans in a batch see earlier ones.
+ * Keyed by (group array index, slot index).
+ */
+struct FInventoryAddPlanOverlay
+{
+	struct FPlannedSlot
+	{
+		uint64 ItemKey = 0;
+		int32 AddedQuantity = 0;
+		int32 MaxStack = 0;
+
+		/** The slot was empty and has been claimed by a planned item object */
+		bool bClaimed = false;
+	};
+
+	TMap<TPair<int32, int32>, FPlannedSlot> Slots;
+
+	FORCEINLINE const FPlannedSlot* Find(int32 GroupIdx, int32 SlotIndex) const
+	{
+		return Slots.Find(TPair<int32, int32>(GroupIdx, SlotIndex));
+	}
+
+	FORCEINLINE FPlannedSlot& FindOrAdd(int32 GroupIdx, int32 SlotIndex)
+	{
+		return Slots.FindOrAdd(TPair<int32, int32>(GroupIdx, SlotIndex));
+	}
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryOperationResult.h"
+#include "InventorySlotHandle.h"
+#include "InventoryBatchResult.generated.h"
+
+class UItemBase;
+
+/**
+ * Outcome of one item in a batched add.
+ * An item can be partly placed: AddedQuantity units went in and OverflowQuantity units were left on the item object.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryBatchAddEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TObjectPtr<UItemBase> Item = nullptr;
+
+	/** Succeeds only if the whole stack was placed */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	FInventoryOperationResult Result;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 AddedQuantity = 0;
+
+	/** Units that did not fit and remain on Item */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 OverflowQuantity = 0;
+
+	/** Group and slot the item object was placed in; INDEX_NONE if it was merged into existing stacks or not placed */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 TypeID = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	FInventorySlotHandle Handle;
+
+	/** True if the item object itself now occupies a slot */
+	FORCEINLINE bool WasPlaced() const
+	{
+		return SlotIndex != INDEX_NONE;
+	}
+};
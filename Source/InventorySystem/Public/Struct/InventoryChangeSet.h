@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventorySlotHandle.h"
+#include "InventoryChangeSet.generated.h"
+
+/** Net change in the total quantity of one item. */
+USTRUCT(BlueprintType)
+struct FInventoryItemDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	FString ItemID;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 Delta = 0;
+};
+
+/**
+ * Everything that changed in an inventory since the previous flush.
+ * A slot written several times appears once; an item added then removed within the frame has no delta.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryChangeSet
+{
+	GENERATED_BODY()
+
+	/** Handles to every slot written since the previous flush, valid as of the flush */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FInventorySlotHandle> ChangedSlots;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FInventoryItemDelta> ItemDeltas;
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return ChangedSlots.Num() == 0 && ItemDeltas.Num() == 0;
+	}
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryContainerSummary.generated.h"
+
+/**
+ * What every connection knows about an inventory, whether or not it has the inventory open.
+ * Lets a client label a chest or corpse (empty, full, item count) without receiving its IGR_OnDemand contents.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryContainerSummary
+{
+	GENERATED_BODY()
+
+	/** Units across every group, counting each stack by its size */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 ItemCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 OccupiedSlots = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 TotalSlots = 0;
+
+	bool operator==(const FInventoryContainerSummary& Other) const
+	{
+		return ItemCount == Other.ItemCount && OccupiedSlots == Other.OccupiedSlots && TotalSlots == Other.TotalSlots;
+	}
+
+	bool operator!=(const FInventoryContainerSummary& Other) const
+	{
+		return !(*this == Other);
+	}
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bits used for a stack count on the wire. Counts that do not fit are escaped and sent packed,
+ * so this only trades size against how often the escape is taken. Server and clients must agree;
+ * override through the module's PublicDefinitions rather than per target.
+ */
+#ifndef INVENTORY_NET_QUANTITY_BITS
+#define INVENTORY_NET_QUANTITY_BITS 10
+#endif
+
+static_assert(INVENTORY_NET_QUANTITY_BITS > 0 && INVENTORY_NET_QUANTITY_BITS < 32, "INVENTORY_NET_QUANTITY_BITS must be in [1, 31]");
+
+/**
+ * Reads or writes a non-negative stack count in INVENTORY_NET_QUANTITY_BITS bits.
+ * The all-ones value escapes to a packed int for counts that do not fit. Negative counts are sent as zero.
+ */
+inline void SerializeInventoryQuantity(FArchive& Ar, int32& Quantity)
+{
+	constexpr uint32 Escape = (1u << INVENTORY_NET_QUANTITY_BITS) - 1;
+
+	uint32 Value = Ar.IsSaving() ? static_cast<uint32>(FMath::Max(Quantity, 0)) : 0;
+	uint32 Bits = FMath::Min(Value, Escape);
+	Ar.SerializeBits(&Bits, INVENTORY_NET_QUANTITY_BITS);
+
+	if (Bits == Escape)
+	{
+		Ar.SerializeIntPacked(Value);
+	}
+	else
+	{
+		Value = Bits;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Quantity = static_cast<int32>(FMath::Min(Value, static_cast<uint32>(MAX_int32)));
+	}
+}
+
+/** Reads or writes a non-negative index as a packed int. INDEX_NONE is not representable; callers send a flag for it. */
+inline void SerializeInventoryIndex(FArchive& Ar, int32& Index)
+{
+	uint32 Value = Ar.IsSaving() ? static_cast<uint32>(FMath::Max(Index, 0)) : 0;
+	Ar.SerializeIntPacked(Value);
+
+	if (Ar.IsLoading())
+	{
+		Index = static_cast<int32>(FMath::Min(Value, static_cast<uint32>(MAX_int32)));
+	}
+}
+
+/** Bits sent and received through one inventory replication path, for the IDM_Network overlay. */
+struct FInventoryReplicationStats
+{
+	/** Updates that wrote or read at least one bit */
+	int32 Updates = 0;
+	int64 TotalBits = 0;
+	int32 LastUpdateBits = 0;
+	int32 PeakUpdateBits = 0;
+
+	void Record(int64 Bits)
+	{
+		if (Bits <= 0)
+		{
+			return;
+		}
+
+		const int32 UpdateBits = static_cast<int32>(FMath::Min<int64>(Bits, MAX_int32));
+		++Updates;
+		TotalBits += Bits;
+		LastUpdateBits = UpdateBits;
+		PeakUpdateBits = FMath::Max(PeakUpdateBits, UpdateBits);
+	}
+
+	/** Sums two paths. LastUpdateBits keeps the larger of the two, since their updates are not ordered. */
+	void Accumulate(const FInventoryReplicationStats& Other)
+	{
+		Updates += Other.Updates;
+		TotalBits += Other.TotalBits;
+		LastUpdateBits = FMath::Max(LastUpdateBits, Other.LastUpdateBits);
+		PeakUpdateBits = FMath::Max(PeakUpdateBits, Other.PeakUpdateBits);
+	}
+
+	float GetAverageBytesPerUpdate() const
+	{
+		return Updates > 0 ? static_cast<float>(TotalBits) / (8.0f * Updates) : 0.0f;
+	}
+
+	void Reset()
+	{
+		*this = FInventoryReplicationStats();
+	}
+};
+
+/** Replication work one inventory component caused, accumulated across net updates. Bytes are in FInventoryReplicationStats. */
+struct FInventoryNetMetrics
+{
+	/** PreReplication calls, one per net update that considered the component */
+	int32 NetUpdates = 0;
+
+	/** Push-model properties marked dirty. The net driver only compares dirty properties, so this is what it compared. */
+	int32 PropertiesMarkedDirty = 0;
+
+	/** Items added to, or moved within, the registered subobject list */
+	int32 SubobjectsRegistered = 0;
+
+	/** Subobjects written by ReplicateSubobjects, which only runs when the owner does not use the registered list */
+	int32 SubobjectsWritten = 0;
+
+	double PreReplicationMs = 0.0;
+	double ReplicateSubobjectsMs = 0.0;
+
+	void Reset()
+	{
+		*this = FInventoryNetMetrics();
+	}
+};
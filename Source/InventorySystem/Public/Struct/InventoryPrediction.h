@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryPrediction.generated.h"
+
+/** Slot operations an owning client may apply locally before the server confirms them. */
+UENUM(BlueprintType)
+enum class EInventoryPredictedOperation : uint8
+{
+	IPO_TransferItem UMETA(DisplayName = "Transfer Item"),
+	IPO_SwapSlots UMETA(DisplayName = "Swap Slots"),
+	IPO_SplitStack UMETA(DisplayName = "Split Stack")
+};
+
+/**
+ * One predicted slot operation, sent from the owning client to the server.
+ * Unused fields keep their defaults: SwapSlots and SplitStack work within FromTypeID.
+ */
+USTRUCT()
+struct FInventoryPredictedRequest
+{
+	GENERATED_BODY()
+
+	/** Client-assigned, increasing per component. The server echoes the last one it processed. */
+	UPROPERTY()
+	int32 PredictionKey = 0;
+
+	UPROPERTY()
+	EInventoryPredictedOperation Operation = EInventoryPredictedOperation::IPO_TransferItem;
+
+	UPROPERTY()
+	int32 FromTypeID = -1;
+
+	UPROPERTY()
+	int32 FromIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 ToTypeID = -1;
+
+	UPROPERTY()
+	int32 ToIndex = INDEX_NONE;
+
+	/** SplitStack amount */
+	UPROPERTY()
+	int32 Quantity = 0;
+};
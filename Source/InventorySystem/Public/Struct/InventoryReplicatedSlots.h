@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Items/ItemBase.h"
+#include "Struct/InventoryNetSerialization.h"
+#include "InventoryReplicatedSlots.generated.h"
+
+class UInventoryComponent;
+struct FInventoryReplicatedSlotArray;
+
+/**
+ * Replicated contents of one occupied slot. Empty slots have no entry,
+ * so a slot being filled, changed or emptied maps to add, change or remove.
+ * NetSerialize sends the indices packed, the stack count bit-packed, and a value stack's class as
+ * an index into the owning component's value class table rather than an object reference.
+ */
+USTRUCT()
+struct FInventoryReplicatedSlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Index into FInventorySlotsGroup's group array */
+	UPROPERTY()
+	int32 GroupIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY()
+	TObjectPtr<UItemBase> Item;
+
+	/** Set instead of Item for value stacks, which have no object to replicate. Resolved from ValueClassIndex on clients. */
+	UPROPERTY()
+	TSubclassOf<UItemBase> ValueItemClass;
+
+	/** ValueItemClass's index in UInventoryComponent's value class table, or INDEX_NONE for an item object */
+	int32 ValueClassIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 Quantity = 0;
+
+	/** False while a value stack's class index has no entry in the received class table yet. */
+	FORCEINLINE bool IsResolved() const { return ValueClassIndex == INDEX_NONE || ValueItemClass != nullptr; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	void PreReplicatedRemove(const FInventoryReplicatedSlotArray& InArraySerializer);
+	void PostReplicatedAdd(const FInventoryReplicatedSlotArray& InArraySerializer);
+	void PostReplicatedChange(const FInventoryReplicatedSlotArray& InArraySerializer);
+};
+
+template <>
+struct TStructOpsTypeTraits<FInventoryReplicatedSlot> : public TStructOpsTypeTraitsBase2<FInventoryReplicatedSlot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Delta-replicated mirror of every occupied slot in an inventory.
+ * The server writes it from the slot groups before replication; clients apply each entry back into their slot groups.
+ */
+USTRUCT()
+struct FInventoryReplicatedSlotArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	TArray<FInventoryReplicatedSlot> Entries;
+
+	/** (GroupIndex, SlotIndex) -> Entries index. Server only, not replicated. */
+	TMap<TPair<int32, int32>, int32> EntryLookup;
+
+	FInventoryReplicationStats NetStats;
+
+public:
+	/**
+	 * Component that owns this struct, so no reference is needed.
+	 * Entries are applied to it on clients, and value stack classes are indexed through its class table.
+	 */
+	UInventoryComponent* Owner = nullptr;
+
+	/**
+	 * Writes one slot's contents, marking only that entry dirty. No-op if the entry already matches.
+	 * @param Item The slot's item, or nullptr if the slot is empty or holds a value stack.
+	 * @param ValueItemClass The value stack's class, or nullptr if the slot holds an item object.
+	 * @param Quantity The slot's stack size.
+	 */
+	void SetSlot(int32 GroupIndex, int32 SlotIndex, UItemBase* Item, TSubclassOf<UItemBase> ValueItemClass, int32 Quantity);
+
+	/** Returns the item replicated for a slot, or nullptr if the slot has no entry. */
+	UItemBase* FindItem(int32 GroupIndex, int32 SlotIndex) const
+	{
+		const int32* EntryIndex = EntryLookup.Find(TPair<int32, int32>(GroupIndex, SlotIndex));
+		return EntryIndex ? Entries[*EntryIndex].Item.Get() : nullptr;
+	}
+
+	/** Removes every entry, e.g. after the slot groups were added or removed and group indices shifted. */
+	void Reset()
+	{
+		if (Entries.Num() > 0)
+		{
+			Entries.Reset();
+			MarkArrayDirty();
+		}
+		EntryLookup.Reset();
+	}
+
+	/** Visits every entry as last received (clients) or written (server). */
+	void ForEachEntry(TFunctionRef<void(const FInventoryReplicatedSlot&)> Visitor) const
+	{
+		for (const FInventoryReplicatedSlot& Entry : Entries)
+		{
+			Visitor(Entry);
+		}
+	}
+
+	/** Applies the value stack entries that arrived before their class table entry. Clients only. */
+	void ResolveValueItemClasses();
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	/** Bits written (server) or read (client) by this mirror's delta updates */
+	FORCEINLINE const FInventoryReplicationStats& GetNetStats() const { return NetStats; }
+
+	void ResetNetStats() { NetStats.Reset(); }
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		const int64 StartBits = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : (DeltaParms.Reader ? DeltaParms.Reader->GetPosBits() : 0);
+
+		const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FInventoryReplicatedSlot, FInventoryReplicatedSlotArray>(Entries, DeltaParms, *this);
+
+		if (DeltaParms.Writer && bResult)
+		{
+			NetStats.Record(DeltaParms.Writer->GetNumBits() - StartBits);
+		}
+		else if (DeltaParms.Reader)
+		{
+			NetStats.Record(DeltaParms.Reader->GetPosBits() - StartBits);
+		}
+
+		return bResult;
+	}
+
+private:
+	void RemoveEntry(int32 EntryIndex)
+	{
+		EntryLookup.Remove(TPair<int32, int32>(Entries[EntryIndex].GroupIndex, Entries[EntryIndex].SlotIndex));
+		Entries.RemoveAtSwap(EntryIndex);
+
+		if (Entries.IsValidIndex(EntryIndex))
+		{
+			const FInventoryReplicatedSlot& Moved = Entries[EntryIndex];
+			EntryLookup.Add(TPair<int32, int32>(Moved.GroupIndex, Moved.SlotIndex), EntryIndex);
+		}
+
+		MarkArrayDirty();
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FInventoryReplicatedSlotArray> : public TStructOpsTypeTraitsBase2<FInventoryReplicatedSlotArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/CoreNet.h"
 #include "Items/ItemBase.h"
+#include "Struct/InventoryNetSerialization.h"
 #include "InventorySlot.generated.h"
 
 /**
  * A single slot within an inventory.
  * Keeps Item, CurrentStackSize, and MaxStackSize in sync to ensure data consistency.
+ *
+ * A slot holds either an item object or, for module-less stackables, a value stack: just the item class and a count.
+ * Value stacks have no UObject until the owning component materializes one; GetItem() returns nullptr for them.
+ * Use GetItemPrototype() for definition data that does not need the object.
  */
 USTRUCT(BlueprintType)
 struct FInventorySlot
@@ -17,6 +23,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
 	TObjectPtr<UItemBase> Item;
 
+	/** Set instead of Item when the slot holds a value stack */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
+	TSubclassOf<UItemBase> ValueItemClass;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
 	int32 CurrentStackSize;
 
@@ -29,10 +39,32 @@ public:
 	{
 	}
 
+	/** The item object, or nullptr for empty slots and value stacks. */
 	FORCEINLINE UItemBase* GetItem() const { return Item; }
 	FORCEINLINE int32 GetCurrentStackSize() const { return CurrentStackSize; }
 	FORCEINLINE int32 GetMaxStackSize() const { return MaxStackSize; }
-	FORCEINLINE bool IsEmpty() const { return Item == nullptr || CurrentStackSize <= 0; }
+	FORCEINLINE bool IsEmpty() const { return (Item == nullptr && ValueItemClass == nullptr) || CurrentStackSize <= 0; }
+	FORCEINLINE bool IsValueStack() const { return Item == nullptr && ValueItemClass != nullptr && CurrentStackSize > 0; }
+	FORCEINLINE TSubclassOf<UItemBase> GetValueItemClass() const { return ValueItemClass; }
+
+	/** Class of whatever the slot holds, object or value stack. */
+	FORCEINLINE TSubclassOf<UItemBase> GetItemClass() const
+	{
+		return Item ? TSubclassOf<UItemBase>(Item->GetClass()) : ValueItemClass;
+	}
+
+	/**
+	 * The item object, or the class defaults for a value stack. Read-only definition data for either kind of slot.
+	 * @return nullptr if the slot is empty.
+	 */
+	FORCEINLINE const UItemBase* GetItemPrototype() const
+	{
+		if (Item)
+		{
+			return Item;
+		}
+		return ValueItemClass ? ValueItemClass->GetDefaultObject<UItemBase>() : nullptr;
+	}
 	FORCEINLINE bool IsFull() const { return CurrentStackSize >= MaxStackSize; }
 	FORCEINLINE int32 GetAvailableSpace() const { return MaxStackSize - CurrentStackSize; }
 
@@ -43,7 +75,7 @@ public:
 			return false;
 		}
 
-		return Item->GetItemDefinition().GetItemID() == InItem->GetItemDefinition().GetItemID();
+		return GetItemPrototype()->GetItemDefinition().GetItemKey() == InItem->GetItemDefinition().GetItemKey();
 	}
 
 	bool CanAcceptItem(const UItemBase* InItem) const
@@ -71,13 +103,30 @@ public:
 		}
 
 		Item = InItem;
+		ValueItemClass = nullptr;
 		MaxStackSize = InItem->GetMaxStackSize();
 		CurrentStackSize = FMath::Clamp(InQuantity, 0, MaxStackSize);
 	}
 
+	/** Makes the slot a value stack of the class. Clears the slot if the class is null. */
+	void SetValueStack(TSubclassOf<UItemBase> InClass, int32 InQuantity)
+	{
+		if (!InClass)
+		{
+			ClearSlot();
+			return;
+		}
+
+		Item = nullptr;
+		ValueItemClass = InClass;
+		MaxStackSize = FMath::Max(InClass->GetDefaultObject<UItemBase>()->GetMaxStackSize(), 1);
+		CurrentStackSize = FMath::Clamp(InQuantity, 0, MaxStackSize);
+	}
+
 	void ClearSlot()
 	{
 		Item = nullptr;
+		ValueItemClass = nullptr;
 		CurrentStackSize = 0;
 		MaxStackSize = 1;
 	}
@@ -121,7 +170,7 @@ public:
 			return 0;
 		}
 
-		if (!TargetSlot.IsEmpty() && !TargetSlot.CanStackItem(Item))
+		if (!TargetSlot.IsEmpty() && !TargetSlot.CanStackItem(GetItemPrototype()))
 		{
 			return 0;
 		}
@@ -137,7 +186,14 @@ public:
 
 		if (TargetSlot.IsEmpty())
 		{
-			TargetSlot.SetItem(Item, ActualTransfer);
+			if (IsValueStack())
+			{
+				TargetSlot.SetValueStack(ValueItemClass, ActualTransfer);
+			}
+			else
+			{
+				TargetSlot.SetItem(Item, ActualTransfer);
+			}
 		}
 		else
 		{
@@ -157,7 +213,7 @@ public:
 		}
 
 		return FString::Printf(TEXT("[%s] %d/%d"),
-			*Item->GetItemDefinition().GetItemName().ToString(),
+			*GetItemPrototype()->GetItemDefinition().GetItemName().ToString(),
 			CurrentStackSize,
 			MaxStackSize);
 	}
@@ -184,12 +240,18 @@ public:
 			bIsValid = false;
 		}
 
-		if (!Item && CurrentStackSize > 0)
+		if (!Item && !ValueItemClass && CurrentStackSize > 0)
 		{
 			OutErrors.Add(TEXT("No item but stack size > 0"));
 			bIsValid = false;
 		}
 
+		if (Item && ValueItemClass)
+		{
+			OutErrors.Add(TEXT("Slot holds both an item object and a value stack"));
+			bIsValid = false;
+		}
+
 		return bIsValid;
 	}
 
@@ -205,11 +267,63 @@ public:
 			return false;
 		}
 
-		return Item == Other.Item && CurrentStackSize == Other.CurrentStackSize;
+		return Item == Other.Item && ValueItemClass == Other.ValueItemClass && CurrentStackSize == Other.CurrentStackSize;
 	}
 
 	bool operator!=(const FInventorySlot& Other) const
 	{
 		return !(*this == Other);
 	}
+
+	/**
+	 * Sends an occupancy bit, then the item object or value stack class and a bit-packed count.
+	 * MaxStackSize is not sent; the receiver takes it from the item or class defaults.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		uint8 bOccupied = Ar.IsSaving() ? !IsEmpty() : 0;
+		Ar.SerializeBits(&bOccupied, 1);
+
+		if (!bOccupied)
+		{
+			if (Ar.IsLoading())
+			{
+				ClearSlot();
+			}
+			bOutSuccess = true;
+			return true;
+		}
+
+		uint8 bValueStack = Ar.IsSaving() ? IsValueStack() : 0;
+		Ar.SerializeBits(&bValueStack, 1);
+
+		UObject* Object = Ar.IsSaving() ? (bValueStack ? static_cast<UObject*>(ValueItemClass.Get()) : Item.Get()) : nullptr;
+		Map->SerializeObject(Ar, bValueStack ? UClass::StaticClass() : UItemBase::StaticClass(), Object);
+
+		int32 Quantity = CurrentStackSize;
+		SerializeInventoryQuantity(Ar, Quantity);
+
+		if (Ar.IsLoading())
+		{
+			Item = bValueStack ? nullptr : Cast<UItemBase>(Object);
+			ValueItemClass = bValueStack ? Cast<UClass>(Object) : nullptr;
+			CurrentStackSize = Quantity;
+
+			// An unmapped object arrives as null; keep the count so the slot fills in once it resolves
+			const UItemBase* Prototype = GetItemPrototype();
+			MaxStackSize = Prototype ? FMath::Max(Prototype->GetMaxStackSize(), 1) : FMath::Max(Quantity, 1);
+		}
+
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FInventorySlot> : public TStructOpsTypeTraitsBase2<FInventorySlot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
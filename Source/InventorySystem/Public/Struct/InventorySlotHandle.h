@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventorySlotHandle.generated.h"
+
+/**
+ * Stable reference to a slot inside an inventory component.
+ * Resolves in O(1) and detects staleness: the generation changes whenever the item object in the slot changes,
+ * so a handle taken before a sort, move or removal no longer resolves instead of pointing at the wrong item.
+ */
+USTRUCT(BlueprintType)
+struct FInventorySlotHandle
+{
+	GENERATED_BODY()
+
+	/** Array index of the group within FInventorySlotsGroup (not a TypeID) */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 GroupIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Slot generation at the time the handle was made */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 Generation = 0;
+
+	FInventorySlotHandle() = default;
+
+	FInventorySlotHandle(int32 InGroupIndex, int32 InSlotIndex, int32 InGeneration)
+		: GroupIndex(InGroupIndex), SlotIndex(InSlotIndex), Generation(InGeneration)
+	{
+	}
+
+	/** True if the handle was ever pointed at a slot. Does not check staleness. */
+	FORCEINLINE bool IsSet() const
+	{
+		return GroupIndex != INDEX_NONE && SlotIndex != INDEX_NONE;
+	}
+
+	void Reset()
+	{
+		*this = FInventorySlotHandle();
+	}
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Group:%d Slot:%d Gen:%d"), GroupIndex, SlotIndex, Generation);
+	}
+
+	bool operator==(const FInventorySlotHandle& Other) const
+	{
+		return GroupIndex == Other.GroupIndex && SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FInventorySlotHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+};
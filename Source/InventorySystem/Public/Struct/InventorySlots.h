@@ -4,8 +4,112 @@
 #include "InventoryOperationResult.h"
 #include "InventorySlot.h"
 #include "Items/ItemBase.h"
+#include "Algo/BinarySearch.h"
+#include "Templates/Function.h"
+#include "InventoryTypeMask.h"
 #include "InventorySlots.generated.h"
 
+/**
+ * Occupied slots of a single item ID within one slot group.
+ * Partial stacks are kept apart from full ones so stack merges never visit full slots.
+ * Both lists stay sorted by slot index to preserve the original fill order.
+ */
+struct FItemStackLocations
+{
+	TArray<int32> PartialSlots;
+	TArray<int32> FullSlots;
+	int32 TotalCount = 0;
+
+	FORCEINLINE bool IsEmpty() const { return PartialSlots.Num() == 0 && FullSlots.Num() == 0; }
+};
+
+/**
+ * Item key -> total quantity across every group of one FInventorySlotsGroup.
+ * Each linked group applies its index deltas here as slots change, so reads never rescan the groups.
+ */
+struct FInventoryItemTotals
+{
+	TMap<uint64, int32> Totals;
+
+	/** Set when a group's contents were replaced wholesale; the owner recounts every group on the next read */
+	bool bNeedsRebuild = true;
+
+	void Apply(uint64 ItemKey, int32 Delta)
+	{
+		if (Delta == 0)
+		{
+			return;
+		}
+
+		int32& Total = Totals.FindOrAdd(ItemKey);
+		Total += Delta;
+		if (Total == 0)
+		{
+			Totals.Remove(ItemKey);
+		}
+	}
+};
+
+/**
+ * A group's link to its owner's FInventoryItemTotals.
+ * Copies start unlinked, so a copied group never writes into another collection's totals.
+ * Assigning over a linked group keeps the link but flags the totals, since the group's contents were replaced.
+ */
+struct FInventoryItemTotalsLink
+{
+	FInventoryItemTotals* Totals = nullptr;
+
+	FInventoryItemTotalsLink() = default;
+	FInventoryItemTotalsLink(const FInventoryItemTotalsLink&) {}
+
+	FInventoryItemTotalsLink& operator=(const FInventoryItemTotalsLink&)
+	{
+		Invalidate();
+		return *this;
+	}
+
+	FORCEINLINE void Apply(uint64 ItemKey, int32 Delta) const
+	{
+		if (Totals)
+		{
+			Totals->Apply(ItemKey, Delta);
+		}
+	}
+
+	FORCEINLINE void Invalidate() const
+	{
+		if (Totals)
+		{
+			Totals->bNeedsRebuild = true;
+		}
+	}
+};
+
+/**
+ * Which connections receive a slot group's contents.
+ */
+UENUM(BlueprintType)
+enum class EInventoryGroupReplication : uint8
+{
+	/** Every connection the owning actor is relevant to */
+	IGR_Public UMETA(DisplayName = "Public"),
+	/** Only the owning connection */
+	IGR_OwnerOnly UMETA(DisplayName = "Owner Only"),
+	/** The owning connection, plus connections with an open session (UInventoryComponent::OpenContainer). Others see a summary. */
+	IGR_OnDemand UMETA(DisplayName = "On Demand")
+};
+
+/** Independent readers of slot change tracking. Each consumes its own set of changed slots. */
+enum class EInventorySlotChangeConsumer : uint8
+{
+	/** Deferred change sets broadcast by the owning component */
+	Notify,
+	/** Server-side sync of the replicated slot array */
+	Replication,
+
+	Count
+};
+
 /**
  * Manages a collection of inventory slots with support for type validation, stacking, and sorting.
  */
@@ -23,10 +127,62 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	TMap<int32, FString> TypeIDMap;
 
-	/** Internal collection of inventory slots */
+	/** Connections that receive this group's contents */
 	UPROPERTY(EditAnywhere, Category = "Inventory")
+	EInventoryGroupReplication ReplicationPolicy = EInventoryGroupReplication::IGR_Public;
+
+	/** Internal collection of inventory slots. Replicated separately through the owning component's slot mirrors. */
+	UPROPERTY(EditAnywhere, NotReplicated, Category = "Inventory")
 	TArray<FInventorySlot> Slots;
 
+	/** Item key -> occupied slots. Transient, rebuilt lazily after replication or direct slot edits. */
+	mutable TMap<uint64, FItemStackLocations> ItemIDIndex;
+
+	/** Item object -> slot holding it. Maintained alongside ItemIDIndex. */
+	mutable TMap<const UItemBase*, int32> ItemSlotIndex;
+
+	/** One bit per slot, set while the slot is occupied. Scanned a word at a time to find free slots. */
+	mutable TArray<uint64> OccupancyWords;
+
+	/** Running count of occupied slots, kept in step with OccupancyWords */
+	mutable int32 OccupiedSlotCount = 0;
+
+	/**
+	 * Structure-of-arrays mirror of Slots, one entry per slot, zero for empty slots.
+	 * Aggregate scans read these contiguous columns instead of dereferencing item pointers.
+	 */
+	mutable TArray<int32> StackSizeColumn;
+	mutable TArray<int32> MaxStackColumn;
+	mutable TArray<uint64> ItemKeyColumn;
+
+	/** Flag to track if the item index and occupancy bitmap need rebuilding */
+	mutable bool bSlotIndexDirty = true;
+
+	/** Bumped on every slot index change, so owners can tell when derived data is stale */
+	mutable uint32 ContentVersion = 0;
+
+	/** Bumped whenever the replicated layout (slot count, replication policy) changes. */
+	uint32 LayoutVersion = 0;
+
+	/**
+	 * Per-slot generation, bumped whenever the item object held by the slot changes. Used by FInventorySlotHandle.
+	 * Survives index rebuilds; SlotItemIdentity remembers which object each generation belongs to and is never dereferenced.
+	 */
+	mutable TArray<int32> SlotGenerations;
+	mutable TArray<const UItemBase*> SlotItemIdentity;
+
+	/** Slots written since each consumer's last ConsumeChangedSlots. Set by IndexSlot; a full index rebuild marks every slot. */
+	mutable TBitArray<> ChangedSlotBits[static_cast<int32>(EInventorySlotChangeConsumer::Count)];
+
+	/** Owner's item totals, kept equal to the sum of TotalCount in ItemIDIndex by IndexSlot, UnindexSlot and ResetSlotIndex */
+	mutable FInventoryItemTotalsLink ItemTotalsLink;
+
+	/** TypeIDMap keys as a mask. Transient, rebuilt lazily. */
+	mutable FInventoryTypeMask TypeMask;
+
+	/** Flag to track if TypeMask needs rebuilding */
+	mutable bool bTypeMaskDirty = true;
+
 public:
 	FInventorySlots() = default;
 
@@ -39,8 +195,11 @@ public:
 	{
 		MaxSlotSize = Size;
 		TypeIDMap = NewTypeIDMap;
+		++LayoutVersion;
+		bTypeMaskDirty = true;
 		Slots.Empty(MaxSlotSize);
 		Slots.SetNum(MaxSlotSize);
+		ResetSlotIndex();
 	}
 
 	/**
@@ -55,26 +214,38 @@ public:
 			return false;
 		}
 
-		const TArray<int32>& ItemTypeIDs = Item->GetItemDefinition().GetInventorySlotTypeIDs();
+		return GetTypeMask().Intersects(Item->GetItemDefinition().GetSlotTypeMask());
+	}
 
-		for (int32 ID : ItemTypeIDs)
+	/** Supported type IDs as a mask, for single-AND compatibility checks. */
+	const FInventoryTypeMask& GetTypeMask() const
+	{
+		if (bTypeMaskDirty)
 		{
-			if (TypeIDMap.Contains(ID))
+			TypeMask.Reset();
+			for (const TPair<int32, FString>& Pair : TypeIDMap)
 			{
-				return true;
+				TypeMask.Add(Pair.Key);
 			}
+			bTypeMaskDirty = false;
 		}
 
-		return false;
+		return TypeMask;
 	}
 
 	/**
 	 * Logic for adding an item, handling stack overflows and empty slot searches.
 	 * @param NewItem The item object to add.
+	 * @param OutSlotIndex Optional. Receives the slot the item object was placed in, or INDEX_NONE if it was fully merged into existing stacks.
 	 * @return An FInventoryOperationResult indicating the outcome of the addition attempt.
 	 */
-	FInventoryOperationResult AddItem(UItemBase* NewItem)
+	FInventoryOperationResult AddItem(UItemBase* NewItem, int32* OutSlotIndex = nullptr)
 	{
+		if (OutSlotIndex)
+		{
+			*OutSlotIndex = INDEX_NONE;
+		}
+
 		if (!IsValid(NewItem))
 		{
 			return FInventoryOperationResult::Fail(TEXT("The item you are trying to add is invalid"));
@@ -89,33 +260,26 @@ public:
 
 		if (NewItem->IsStackable())
 		{
-			for (FInventorySlot& Slot : Slots)
+			RemainingToStack = FillPartialStacks(NewItem->GetItemDefinition().GetItemKey(), RemainingToStack);
+
+			if (RemainingToStack <= 0)
 			{
-				if (!Slot.IsEmpty() &&
-					Slot.GetItem()->GetItemDefinition().GetItemID() == NewItem->GetItemDefinition().GetItemID())
-				{
-					if (!Slot.IsFull())
-					{
-						RemainingToStack = Slot.AddToStack(RemainingToStack);
-
-						if (RemainingToStack <= 0)
-						{
-							return FInventoryOperationResult::Ok();
-						}
-					}
-				}
+				return FInventoryOperationResult::Ok();
 			}
 		}
 
 		if (RemainingToStack > 0)
 		{
-			for (FInventorySlot& Slot : Slots)
+			const int32 Index = FindFirstEmptySlot();
+			if (Index != INDEX_NONE)
 			{
-				if (Slot.IsEmpty())
+				Slots[Index].SetItem(NewItem, RemainingToStack);
+				IndexSlot(Index);
+				if (OutSlotIndex)
 				{
-					Slot.SetItem(NewItem, RemainingToStack);
-					return FInventoryOperationResult::Ok();
+					*OutSlotIndex = Index;
 				}
+				return FInventoryOperationResult::Ok();
 			}
 		}
 
@@ -153,15 +317,16 @@ public:
 		if (TargetSlot.IsEmpty())
 		{
 			TargetSlot.SetItem(NewItem, NewItem->GetCurrentStackSize());
+			IndexSlot(TargetIndex);
 			return FInventoryOperationResult::Ok();
 		}
 
 		if (NewItem->IsStackable() &&
-			TargetSlot.GetItem()->GetItemDefinition().GetItemID() == NewItem->GetItemDefinition().GetItemID())
+			TargetSlot.GetItemPrototype()->GetItemDefinition().GetItemKey() == NewItem->GetItemDefinition().GetItemKey())
 		{
 			if (!TargetSlot.IsFull())
 			{
-				int32 Overflow = TargetSlot.AddToStack(NewItem->GetCurrentStackSize());
+				int32 Overflow = AddToSlotStack(TargetIndex, NewItem->GetCurrentStackSize());
 
 				if (Overflow <= 0)
 				{
@@ -179,14 +344,16 @@ public:
 	/**
 	 * Clears a slot and returns the item reference.
 	 * @param Index Target slot index.
-	 * @return Pointer to the item previously in the slot.
+	 * @return Pointer to the item previously in the slot. nullptr for a value stack.
 	 */
 	UItemBase* RemoveItem(int32 Index)
 	{
 		if (Slots.IsValidIndex(Index) && !Slots[Index].IsEmpty())
 		{
 			UItemBase* RemovedItem = Slots[Index].GetItem();
+			UnindexSlot(Index);
 			Slots[Index].ClearSlot();
+			IndexSlot(Index);
 			return RemovedItem;
 		}
 
@@ -202,6 +369,8 @@ public:
 		{
 			Slot.ClearSlot();
 		}
+
+		ResetSlotIndex();
 	}
 
 	/**
@@ -218,7 +387,11 @@ public:
 				FString::Printf(TEXT("Invalid slot index: A=%d, B=%d"), IndexA, IndexB));
 		}
 
+		UnindexSlot(IndexA);
+		UnindexSlot(IndexB);
 		Slots.Swap(IndexA, IndexB);
+		IndexSlot(IndexA);
+		IndexSlot(IndexB);
 		return FInventoryOperationResult::Ok();
 	}
 
@@ -257,6 +430,19 @@ public:
 			return FInventoryOperationResult::Fail(TEXT("Split amount must be less than current stack size"));
 		}
 
+		// Value stacks split without creating any object
+		if (Slots[SourceIndex].IsValueStack())
+		{
+			const TSubclassOf<UItemBase> ValueClass = Slots[SourceIndex].GetValueItemClass();
+			const int32 Remaining = Slots[SourceIndex].GetCurrentStackSize() - Amount;
+			UnindexSlot(SourceIndex);
+			Slots[SourceIndex].SetValueStack(ValueClass, Remaining);
+			Slots[TargetIndex].SetValueStack(ValueClass, Amount);
+			IndexSlot(SourceIndex);
+			IndexSlot(TargetIndex);
+			return FInventoryOperationResult::Ok();
+		}
+
 		UItemBase* OriginalItem = Slots[SourceIndex].GetItem();
 		if (!OriginalItem)
 		{
@@ -269,8 +455,11 @@ public:
 			return FInventoryOperationResult::Fail(TEXT("Failed to create split item instance"));
 		}
 
+		UnindexSlot(SourceIndex);
 		Slots[SourceIndex].SetItem(OriginalItem, OriginalItem->GetCurrentStackSize());
 		Slots[TargetIndex].SetItem(NewItem, Amount);
+		IndexSlot(SourceIndex);
+		IndexSlot(TargetIndex);
 
 		return FInventoryOperationResult::Ok();
 	}
@@ -294,6 +483,8 @@ public:
 				WriteIndex++;
 			}
 		}
+
+		bSlotIndexDirty = true;
 	}
 
 	/**
@@ -318,15 +509,29 @@ public:
 	 */
 	const FInventorySlot* FindSlotByItemID(const FString& ItemID) const
 	{
-		for (const FInventorySlot& Slot : Slots)
+		return FindSlotByItemKey(FItemDefinition::MakeItemKey(ItemID));
+	}
+
+	/**
+	 * Finds the first slot containing an item with a specific key.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return A pointer to the found slot, or nullptr if not found.
+	 */
+	const FInventorySlot* FindSlotByItemKey(uint64 ItemKey) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		if (!Locations)
 		{
-			if (!Slot.IsEmpty() && Slot.GetItem()->GetItemDefinition().GetItemID() == ItemID)
-			{
-				return &Slot;
-			}
+			return nullptr;
 		}
 
-		return nullptr;
+		int32 FirstIndex = Locations->PartialSlots.Num() > 0 ? Locations->PartialSlots[0] : MAX_int32;
+		if (Locations->FullSlots.Num() > 0)
+		{
+			FirstIndex = FMath::Min(FirstIndex, Locations->FullSlots[0]);
+		}
+
+		return Slots.IsValidIndex(FirstIndex) ? &Slots[FirstIndex] : nullptr;
 	}
 
 	/**
@@ -336,17 +541,254 @@ public:
 	 */
 	int32 GetTotalItemCount(const FString& ItemID) const
 	{
-		int32 Total = 0;
+		return GetTotalItemCount(FItemDefinition::MakeItemKey(ItemID));
+	}
 
-		for (const FInventorySlot& Slot : Slots)
+	/**
+	 * Calculates the total quantity of a specific item across all slots.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return Total count of the item.
+	 */
+	int32 GetTotalItemCount(uint64 ItemKey) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		return Locations ? Locations->TotalCount : 0;
+	}
+
+	/**
+	 * Visits the total quantity of every item held in this group.
+	 * @param Visitor Called once per item key with its total quantity.
+	 */
+	void ForEachItemTotal(TFunctionRef<void(uint64, int32)> Visitor) const
+	{
+		EnsureSlotIndex();
+
+		for (const TPair<uint64, FItemStackLocations>& Pair : ItemIDIndex)
 		{
-			if (!Slot.IsEmpty() && Slot.GetItem()->GetItemDefinition().GetItemID() == ItemID)
-			{
-				Total += Slot.GetCurrentStackSize();
-			}
+			Visitor(Pair.Key, Pair.Value.TotalCount);
 		}
+	}
 
-		return Total;
+	/**
+	 * Links this group to a collection's item totals and adds its current totals to them.
+	 * From then on every slot index change is applied to the totals as it happens.
+	 * @param Totals The totals to report into, or nullptr to unlink.
+	 */
+	void LinkItemTotals(FInventoryItemTotals* Totals) const
+	{
+		// Unlinked while the index is brought up to date, so a pending rebuild does not report into the new totals
+		ItemTotalsLink.Totals = nullptr;
+		EnsureSlotIndex();
+		ItemTotalsLink.Totals = Totals;
+
+		for (const TPair<uint64, FItemStackLocations>& Pair : ItemIDIndex)
+		{
+			ItemTotalsLink.Apply(Pair.Key, Pair.Value.TotalCount);
+		}
+	}
+
+	/**
+	 * Returns the generation of a slot, for building or checking FInventorySlotHandle.
+	 * @param Index The slot index.
+	 * @return Current generation, or INDEX_NONE for an invalid index.
+	 */
+	int32 GetSlotGeneration(int32 Index) const
+	{
+		EnsureSlotIndex();
+		return SlotGenerations.IsValidIndex(Index) ? SlotGenerations[Index] : INDEX_NONE;
+	}
+
+	/**
+	 * Visits every slot written since the consumer's previous call, then clears that consumer's set.
+	 * @param Consumer Whose changed set to drain. Other consumers are unaffected.
+	 * @param Visitor Called with each changed slot index, in index order.
+	 */
+	void ConsumeChangedSlots(EInventorySlotChangeConsumer Consumer, TFunctionRef<void(int32)> Visitor)
+	{
+		EnsureSlotIndex();
+
+		TBitArray<>& Bits = ChangedSlotBits[static_cast<int32>(Consumer)];
+		for (TConstSetBitIterator<> It(Bits); It; ++It)
+		{
+			Visitor(It.GetIndex());
+		}
+
+		Bits.Init(false, Slots.Num());
+	}
+
+	/** Returns a counter that changes whenever the slot count is reinitialized or the replication policy changes. */
+	FORCEINLINE uint32 GetLayoutVersion() const { return LayoutVersion; }
+
+	/** Returns a counter that changes whenever slot contents change. */
+	uint32 GetContentVersion() const
+	{
+		EnsureSlotIndex();
+		return ContentVersion;
+	}
+
+	/**
+	 * Checks whether any stack of the given item still has room.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return True if at least one partial stack exists.
+	 */
+	bool HasPartialStack(uint64 ItemKey) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		return Locations && Locations->PartialSlots.Num() > 0;
+	}
+
+	/**
+	 * Collects the slots holding partial stacks of an item, in slot order.
+	 * Returned by value so callers may mutate the slots while iterating.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return Indices of non-full slots containing the item.
+	 */
+	TArray<int32> GetPartialStackSlots(uint64 ItemKey) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		return Locations ? Locations->PartialSlots : TArray<int32>();
+	}
+
+	/**
+	 * Visits every stack of an item, partial stacks first, each in slot order.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @param Visitor Called with the slot index and its stack size. Must not modify this group.
+	 */
+	void ForEachItemStack(uint64 ItemKey, TFunctionRef<void(int32, int32)> Visitor) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		if (!Locations)
+		{
+			return;
+		}
+
+		for (int32 Index : Locations->PartialSlots)
+		{
+			Visitor(Index, StackSizeColumn[Index]);
+		}
+
+		for (int32 Index : Locations->FullSlots)
+		{
+			Visitor(Index, StackSizeColumn[Index]);
+		}
+	}
+
+	/**
+	 * Adds units to an occupied slot's stack.
+	 * @param SlotIndex The index of the slot to grow.
+	 * @param Amount Quantity to add.
+	 * @return Overflow amount that did not fit.
+	 */
+	int32 AddToSlotStack(int32 SlotIndex, int32 Amount)
+	{
+		if (!Slots.IsValidIndex(SlotIndex))
+		{
+			return Amount;
+		}
+
+		UnindexSlot(SlotIndex);
+		const int32 Overflow = Slots[SlotIndex].AddToStack(Amount);
+		IndexSlot(SlotIndex);
+		return Overflow;
+	}
+
+	/**
+	 * Overwrites a slot's item and quantity. Used to apply staged changes that were validated elsewhere.
+	 * @param SlotIndex The index of the slot to write.
+	 * @param Item The item object to hold, or nullptr to clear the slot.
+	 * @param Quantity Stack size to set. Clamped to the item's max stack size.
+	 */
+	void SetSlotContents(int32 SlotIndex, UItemBase* Item, int32 Quantity)
+	{
+		if (!Slots.IsValidIndex(SlotIndex))
+		{
+			return;
+		}
+
+		UnindexSlot(SlotIndex);
+		if (IsValid(Item) && Quantity > 0)
+		{
+			Slots[SlotIndex].SetItem(Item, Quantity);
+		}
+		else
+		{
+			Slots[SlotIndex].ClearSlot();
+		}
+		IndexSlot(SlotIndex);
+	}
+
+	/**
+	 * Makes a slot a value stack: a class and a count with no item object.
+	 * @param ItemClass Module-less stackable class (UItemBase::SupportsValueStacks), or nullptr to clear the slot.
+	 * @param Quantity Stack size to set. Clamped to the class's max stack size.
+	 */
+	void SetValueStackContents(int32 SlotIndex, TSubclassOf<UItemBase> ItemClass, int32 Quantity)
+	{
+		if (!Slots.IsValidIndex(SlotIndex))
+		{
+			return;
+		}
+
+		UnindexSlot(SlotIndex);
+		if (ItemClass && Quantity > 0)
+		{
+			Slots[SlotIndex].SetValueStack(ItemClass, Quantity);
+		}
+		else
+		{
+			Slots[SlotIndex].ClearSlot();
+		}
+		IndexSlot(SlotIndex);
+	}
+
+	/**
+	 * Replaces a value stack with an item object holding the same units. Keeps the slot generation, so existing handles stay valid.
+	 * @param Item Freshly created object of the value stack's class.
+	 * @return False if the slot is not a value stack.
+	 */
+	bool MaterializeSlot(int32 SlotIndex, UItemBase* Item)
+	{
+		if (!Slots.IsValidIndex(SlotIndex) || !Slots[SlotIndex].IsValueStack() || !IsValid(Item))
+		{
+			return false;
+		}
+
+		UnindexSlot(SlotIndex);
+		Slots[SlotIndex].SetItem(Item, Slots[SlotIndex].GetCurrentStackSize());
+		if (SlotItemIdentity.IsValidIndex(SlotIndex))
+		{
+			SlotItemIdentity[SlotIndex] = Item;
+		}
+		IndexSlot(SlotIndex);
+		return true;
+	}
+
+	/**
+	 * Moves units from one slot into an empty or stack-compatible slot, possibly in another group.
+	 * Works for value stacks as well as item objects; an object only moves when the whole stack goes to an empty slot.
+	 * @param DestGroup Group holding ToIndex. May be this group.
+	 * @return Units actually moved.
+	 */
+	int32 TransferSlotContents(int32 FromIndex, FInventorySlots& DestGroup, int32 ToIndex, int32 Amount)
+	{
+		if (!Slots.IsValidIndex(FromIndex) || !DestGroup.Slots.IsValidIndex(ToIndex)
+			|| (&DestGroup == this && FromIndex == ToIndex))
+		{
+			return 0;
+		}
+
+		const FInventorySlot& Source = Slots[FromIndex];
+		if (!Source.IsValueStack() && DestGroup.Slots[ToIndex].IsEmpty() && Amount < Source.GetCurrentStackSize())
+		{
+			return 0;
+		}
+
+		UnindexSlot(FromIndex);
+		DestGroup.UnindexSlot(ToIndex);
+		const int32 Moved = Slots[FromIndex].TransferTo(DestGroup.Slots[ToIndex], Amount);
+		IndexSlot(FromIndex);
+		DestGroup.IndexSlot(ToIndex);
+		return Moved;
 	}
 
 	/**
@@ -355,17 +797,175 @@ public:
 	 */
 	int32 GetOccupiedSlotCount() const
 	{
-		int32 Count = 0;
+		EnsureSlotIndex();
+		return OccupiedSlotCount;
+	}
+
+	/**
+	 * Returns the free room left in partial stacks of an item.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return Units that can still be merged into existing stacks.
+	 */
+	int32 GetStackRoom(uint64 ItemKey) const
+	{
+		const FItemStackLocations* Locations = FindItemLocations(ItemKey);
+		if (!Locations)
+		{
+			return 0;
+		}
+
+		int32 Room = 0;
+		for (int32 Index : Locations->PartialSlots)
+		{
+			Room += MaxStackColumn[Index] - StackSizeColumn[Index];
+		}
+
+		return Room;
+	}
+
+	/**
+	 * Sums the stack sizes of every slot with a 4-wide vector scan of the stack size column.
+	 * @return Total item units held in this group.
+	 */
+	int32 GetTotalStackUnits() const
+	{
+		EnsureSlotIndex();
+
+		const int32* Data = StackSizeColumn.GetData();
+		const int32 Num = StackSizeColumn.Num();
+		const int32 VectorEnd = Num & ~3;
+
+		VectorRegister4Int Sum = GlobalVectorConstants::IntZero;
+		for (int32 Index = 0; Index < VectorEnd; Index += 4)
+		{
+			Sum = VectorIntAdd(Sum, VectorIntLoad(Data + Index));
+		}
+
+		alignas(16) int32 Lanes[4];
+		VectorIntStoreAligned(Sum, Lanes);
+
+		int32 Total = Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+		for (int32 Index = VectorEnd; Index < Num; ++Index)
+		{
+			Total += Data[Index];
+		}
+
+		return Total;
+	}
+
+	/**
+	 * Visits occupied slots in index order, skipping empty runs a word at a time via the occupancy bitmap.
+	 * @param Visitor Called with the slot index and slot. Must not add or remove items.
+	 */
+	void ForEachOccupiedSlot(TFunctionRef<void(int32, const FInventorySlot&)> Visitor) const
+	{
+		EnsureSlotIndex();
+
+		for (int32 WordIndex = 0; WordIndex < OccupancyWords.Num(); ++WordIndex)
+		{
+			uint64 Word = OccupancyWords[WordIndex];
+			while (Word != 0)
+			{
+				const int32 Index = WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+				Visitor(Index, Slots[Index]);
+				Word &= Word - 1;
+			}
+		}
+	}
+
+	/**
+	 * Checks the transient slot index against the slot array.
+	 * @param OutErrors Receives a description of each mismatch.
+	 * @return True if the index matches the slots.
+	 */
+	bool ValidateSlotIndex(TArray<FString>& OutErrors) const
+	{
+		EnsureSlotIndex();
+
+		bool bIsValid = true;
+		int32 Occupied = 0;
+
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			const FInventorySlot& Slot = Slots[Index];
+			const bool bOccupied = !Slot.IsEmpty();
+			const bool bIndexed = (OccupancyWords[Index >> 6] & (1ull << (Index & 63))) != 0;
+			Occupied += bOccupied ? 1 : 0;
+
+			if (bOccupied != bIndexed)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Slot %d: occupancy bit out of date"), Index));
+				bIsValid = false;
+				continue;
+			}
+
+			const int32 ExpectedStack = bOccupied ? Slot.GetCurrentStackSize() : 0;
+			const UItemBase* Prototype = bOccupied ? Slot.GetItemPrototype() : nullptr;
+			const uint64 ExpectedKey = IsValid(Prototype) ? Prototype->GetItemDefinition().GetItemKey() : 0;
+			if (StackSizeColumn[Index] != ExpectedStack || ItemKeyColumn[Index] != ExpectedKey)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Slot %d: column data out of date"), Index));
+				bIsValid = false;
+			}
+		}
+
+		if (Occupied != OccupiedSlotCount)
+		{
+			OutErrors.Add(FString::Printf(TEXT("Occupied count %d does not match %d occupied slots"),
+				OccupiedSlotCount, Occupied));
+			bIsValid = false;
+		}
+
+		return bIsValid;
+	}
+
+	/**
+	 * Finds the slot holding a specific item object.
+	 * @param Item The item to look up.
+	 * @return Slot index, or INDEX_NONE if the item is not in this group.
+	 */
+	int32 FindSlotByItem(const UItemBase* Item) const
+	{
+		EnsureSlotIndex();
+		const int32* IndexPtr = ItemSlotIndex.Find(Item);
+		return IndexPtr ? *IndexPtr : INDEX_NONE;
+	}
 
-		for (const FInventorySlot& Slot : Slots)
+	/**
+	 * Finds the lowest-index empty slot with a word-wise scan of the occupancy bitmap.
+	 * @return Slot index, or INDEX_NONE if every slot is occupied.
+	 */
+	int32 FindFirstEmptySlot() const
+	{
+		return FindNextEmptySlot(0);
+	}
+
+	/**
+	 * Finds the lowest-index empty slot at or after StartIndex with a word-wise scan of the occupancy bitmap.
+	 * @param StartIndex First slot index to consider.
+	 * @return Slot index, or INDEX_NONE if no later slot is empty.
+	 */
+	int32 FindNextEmptySlot(int32 StartIndex) const
+	{
+		EnsureSlotIndex();
+
+		StartIndex = FMath::Max(StartIndex, 0);
+		for (int32 WordIndex = StartIndex >> 6; WordIndex < OccupancyWords.Num(); ++WordIndex)
 		{
-			if (!Slot.IsEmpty())
+			uint64 FreeBits = ~OccupancyWords[WordIndex];
+			if (WordIndex == (StartIndex >> 6))
 			{
-				Count++;
+				FreeBits &= ~0ull << (StartIndex & 63);
+			}
+
+			if (FreeBits != 0)
+			{
+				const int32 Index = WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(FreeBits));
+				return Index < Slots.Num() ? Index : INDEX_NONE;
 			}
 		}
 
-		return Count;
+		return INDEX_NONE;
 	}
 
 	/**
@@ -391,7 +991,9 @@ public:
 			return FInventoryOperationResult::Fail(TEXT("Amount must be greater than zero"));
 		}
 
+		UnindexSlot(SlotIndex);
 		int32 Removed = Slots[SlotIndex].RemoveFromStack(Amount);
+		IndexSlot(SlotIndex);
 		if (Removed > 0)
 		{
 			return FInventoryOperationResult::Ok();
@@ -417,7 +1019,9 @@ public:
 			return FInventoryOperationResult::Fail(TEXT("Slot is already empty"));
 		}
 
+		UnindexSlot(SlotIndex);
 		Slots[SlotIndex].ClearSlot();
+		IndexSlot(SlotIndex);
 		return FInventoryOperationResult::Ok();
 	}
 
@@ -438,26 +1042,18 @@ public:
 
 		if (NewItem->IsStackable())
 		{
-			for (FInventorySlot& Slot : Slots)
-			{
-				if (!Slot.IsEmpty() && Slot.GetItem()->GetItemDefinition().GetItemID() == NewItem->GetItemDefinition().
-					GetItemID())
-				{
-					Remaining = Slot.AddToStack(Remaining);
-					if (Remaining <= 0) return 0;
-				}
-			}
+			Remaining = FillPartialStacks(NewItem->GetItemDefinition().GetItemKey(), Remaining);
+			if (Remaining <= 0) return 0;
 		}
 
 		if (Remaining > 0)
 		{
-			for (FInventorySlot& Slot : Slots)
+			const int32 Index = FindFirstEmptySlot();
+			if (Index != INDEX_NONE)
 			{
-				if (Slot.IsEmpty())
-				{
-					Slot.SetItem(NewItem, Remaining);
-					return 0;
-				}
+				Slots[Index].SetItem(NewItem, Remaining);
+				IndexSlot(Index);
+				return 0;
 			}
 		}
 
@@ -484,50 +1080,340 @@ public:
 		return TypeIDMap;
 	}
 
+	FORCEINLINE EInventoryGroupReplication GetReplicationPolicy() const
+	{
+		return ReplicationPolicy;
+	}
+
+	/** True if only the owning connection receives this group. */
+	FORCEINLINE bool IsOwnerReplicated() const
+	{
+		return ReplicationPolicy == EInventoryGroupReplication::IGR_OwnerOnly;
+	}
+
+	void SetReplicationPolicy(EInventoryGroupReplication NewPolicy)
+	{
+		if (ReplicationPolicy != NewPolicy)
+		{
+			ReplicationPolicy = NewPolicy;
+			++LayoutVersion;
+		}
+	}
+
 	FORCEINLINE const TArray<FInventorySlot>& GetSlots() const
 	{
 		return Slots;
 	}
 
+	/** Direct slot access bypasses the slot index, so it is marked for rebuild on next lookup. */
 	FORCEINLINE TArray<FInventorySlot>& GetSlotsMutable()
 	{
+		bSlotIndexDirty = true;
+		ItemTotalsLink.Invalidate();
 		return Slots;
 	}
 
+	/** Call this after slot data changed outside of this struct (e.g. replication) to force an index rebuild. */
+	void MarkSlotIndexDirty()
+	{
+		bSlotIndexDirty = true;
+		bTypeMaskDirty = true;
+		ItemTotalsLink.Invalidate();
+	}
+
+	/**
+	 * Rebuilds the item ID index, item slot index and occupancy bitmap from the slot array.
+	 */
+	void RebuildSlotIndex() const
+	{
+		ResetSlotIndex();
+
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			IndexSlot(Index);
+		}
+	}
+
+	/**
+	 * Sends the layout only: slot count, replication policy and TypeIDMap as packed key/name pairs.
+	 * Property replication skips TMaps, so without this clients never received TypeIDMap.
+	 * Slots are not sent; they replicate through the owning component's slot mirrors, which hold occupied slots only.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		SerializeInventoryIndex(Ar, MaxSlotSize);
+
+		uint32 Policy = static_cast<uint32>(ReplicationPolicy);
+		Ar.SerializeInt(Policy, static_cast<uint32>(EInventoryGroupReplication::IGR_OnDemand) + 1);
+
+		int32 NumTypes = TypeIDMap.Num();
+		SerializeInventoryIndex(Ar, NumTypes);
+
+		if (Ar.IsSaving())
+		{
+			for (const TPair<int32, FString>& Pair : TypeIDMap)
+			{
+				uint32 Key = static_cast<uint32>(Pair.Key);
+				FString Name = Pair.Value;
+				Ar.SerializeIntPacked(Key);
+				Ar << Name;
+			}
+		}
+		else
+		{
+			TMap<int32, FString> NewTypeIDMap;
+			for (int32 i = 0; i < NumTypes && !Ar.IsError(); ++i)
+			{
+				uint32 Key = 0;
+				FString Name;
+				Ar.SerializeIntPacked(Key);
+				Ar << Name;
+				NewTypeIDMap.Add(static_cast<int32>(Key), MoveTemp(Name));
+			}
+
+			if (Ar.IsError())
+			{
+				bOutSuccess = false;
+				return false;
+			}
+
+			const EInventoryGroupReplication NewPolicy = static_cast<EInventoryGroupReplication>(Policy);
+			if (ReplicationPolicy != NewPolicy || !TypeIDMap.OrderIndependentCompareEqual(NewTypeIDMap))
+			{
+				ReplicationPolicy = NewPolicy;
+				TypeIDMap = MoveTemp(NewTypeIDMap);
+				bTypeMaskDirty = true;
+				++LayoutVersion;
+			}
+		}
+
+		bOutSuccess = true;
+		return true;
+	}
+
 private:
+	FORCEINLINE void EnsureSlotIndex() const
+	{
+		if (bSlotIndexDirty)
+		{
+			RebuildSlotIndex();
+		}
+	}
+
+	/** Empties the slot index and sizes the bitmap and columns to the current slot count. */
+	void ResetSlotIndex() const
+	{
+		// Withdraws this group's share of the owner's totals; re-indexing the slots adds it back
+		for (const TPair<uint64, FItemStackLocations>& Pair : ItemIDIndex)
+		{
+			ItemTotalsLink.Apply(Pair.Key, -Pair.Value.TotalCount);
+		}
+
+		ItemIDIndex.Reset();
+		ItemSlotIndex.Reset();
+		OccupancyWords.Reset();
+		OccupancyWords.SetNumZeroed((Slots.Num() + 63) / 64);
+		OccupiedSlotCount = 0;
+		StackSizeColumn.Reset();
+		StackSizeColumn.SetNumZeroed(Slots.Num());
+		MaxStackColumn.Reset();
+		MaxStackColumn.SetNumZeroed(Slots.Num());
+		ItemKeyColumn.Reset();
+		ItemKeyColumn.SetNumZeroed(Slots.Num());
+		++ContentVersion;
+		bSlotIndexDirty = false;
+
+		for (TBitArray<>& Bits : ChangedSlotBits)
+		{
+			Bits.Init(true, Slots.Num());
+		}
+
+		SlotGenerations.SetNumZeroed(Slots.Num());
+		SlotItemIdentity.SetNumZeroed(Slots.Num());
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			SyncSlotGeneration(Index);
+		}
+	}
+
+	/**
+	 * Bumps the slot's generation if it now holds a different item object than when last seen.
+	 * A value stack's identity is its class defaults.
+	 */
+	FORCEINLINE void SyncSlotGeneration(int32 Index) const
+	{
+		const FInventorySlot& Slot = Slots[Index];
+		const UItemBase* Current = Slot.IsEmpty() ? nullptr : Slot.GetItemPrototype();
+		if (SlotItemIdentity[Index] != Current)
+		{
+			SlotItemIdentity[Index] = Current;
+			++SlotGenerations[Index];
+		}
+	}
+
+	const FItemStackLocations* FindItemLocations(uint64 ItemKey) const
+	{
+		EnsureSlotIndex();
+		return ItemIDIndex.Find(ItemKey);
+	}
+
+	/** Adds an occupied slot to the slot index. Must follow every slot mutation. */
+	void IndexSlot(int32 Index) const
+	{
+		if (bSlotIndexDirty)
+		{
+			return;
+		}
+
+		SyncSlotGeneration(Index);
+		for (TBitArray<>& Bits : ChangedSlotBits)
+		{
+			Bits[Index] = true;
+		}
+
+		const FInventorySlot& Slot = Slots[Index];
+		if (Slot.IsEmpty())
+		{
+			return;
+		}
+
+		OccupancyWords[Index >> 6] |= 1ull << (Index & 63);
+		++OccupiedSlotCount;
+		++ContentVersion;
+		if (Slot.GetItem())
+		{
+			ItemSlotIndex.Add(Slot.GetItem(), Index);
+		}
+
+		const uint64 ItemKey = Slot.GetItemPrototype()->GetItemDefinition().GetItemKey();
+		StackSizeColumn[Index] = Slot.GetCurrentStackSize();
+		MaxStackColumn[Index] = Slot.GetMaxStackSize();
+		ItemKeyColumn[Index] = ItemKey;
+
+		FItemStackLocations& Locations = ItemIDIndex.FindOrAdd(ItemKey);
+		TArray<int32>& Target = Slot.IsFull() ? Locations.FullSlots : Locations.PartialSlots;
+		Target.Insert(Index, Algo::LowerBound(Target, Index));
+		Locations.TotalCount += Slot.GetCurrentStackSize();
+		ItemTotalsLink.Apply(ItemKey, Slot.GetCurrentStackSize());
+	}
+
+	/** Removes an occupied slot from the slot index. Must precede every slot mutation. */
+	void UnindexSlot(int32 Index) const
+	{
+		const FInventorySlot& Slot = Slots[Index];
+		if (bSlotIndexDirty || Slot.IsEmpty())
+		{
+			return;
+		}
+
+		OccupancyWords[Index >> 6] &= ~(1ull << (Index & 63));
+		--OccupiedSlotCount;
+		++ContentVersion;
+		if (const int32* MappedIndex = Slot.GetItem() ? ItemSlotIndex.Find(Slot.GetItem()) : nullptr;
+			MappedIndex && *MappedIndex == Index)
+		{
+			ItemSlotIndex.Remove(Slot.GetItem());
+		}
+		StackSizeColumn[Index] = 0;
+		MaxStackColumn[Index] = 0;
+		ItemKeyColumn[Index] = 0;
+
+		const uint64 ItemKey = Slot.GetItemPrototype()->GetItemDefinition().GetItemKey();
+		FItemStackLocations* Locations = ItemIDIndex.Find(ItemKey);
+		if (!Locations)
+		{
+			return;
+		}
+
+		TArray<int32>& Source = Slot.IsFull() ? Locations->FullSlots : Locations->PartialSlots;
+		const int32 Position = Algo::BinarySearch(Source, Index);
+		if (Position != INDEX_NONE)
+		{
+			Source.RemoveAt(Position);
+		}
+		Locations->TotalCount -= Slot.GetCurrentStackSize();
+		ItemTotalsLink.Apply(ItemKey, -Slot.GetCurrentStackSize());
+
+		if (Locations->IsEmpty())
+		{
+			ItemIDIndex.Remove(ItemKey);
+		}
+	}
+
+	/**
+	 * Tops up existing partial stacks of an item in slot order.
+	 * @return Amount that did not fit into existing stacks.
+	 */
+	int32 FillPartialStacks(uint64 ItemKey, int32 Amount)
+	{
+		for (int32 Index : GetPartialStackSlots(ItemKey))
+		{
+			Amount = AddToSlotStack(Index, Amount);
+			if (Amount <= 0)
+			{
+				break;
+			}
+		}
+
+		return Amount;
+	}
+
 	/**
 	 * Merges partial stacks of the same item type together.
+	 * Drains the last partial stack of each item into the first, so full stacks are never touched.
 	 */
 	void ConsolidateStacks()
 	{
-		for (int32 i = 0; i < Slots.Num(); ++i)
+		EnsureSlotIndex();
+
+		TArray<TArray<int32>> PartialRuns;
+		for (const TPair<uint64, FItemStackLocations>& Pair : ItemIDIndex)
 		{
-			if (Slots[i].IsEmpty() || !Slots[i].GetItem()->IsStackable() || Slots[i].IsFull())
+			if (Pair.Value.PartialSlots.Num() > 1)
 			{
-				continue;
+				PartialRuns.Add(Pair.Value.PartialSlots);
 			}
+		}
+
+		for (const TArray<int32>& Run : PartialRuns)
+		{
+			int32 Front = 0;
+			int32 Back = Run.Num() - 1;
 
-			for (int32 j = i + 1; j < Slots.Num(); ++j)
+			while (Front < Back)
 			{
-				if (Slots[j].IsEmpty() ||
-					Slots[j].GetItem()->GetItemDefinition().GetItemID() != Slots[i].GetItem()->GetItemDefinition().
-					GetItemID())
-				{
-					continue;
-				}
+				const int32 FrontIndex = Run[Front];
+				const int32 BackIndex = Run[Back];
 
-				int32 RoomInI = Slots[i].GetAvailableSpace();
-				int32 AmountInJ = Slots[j].GetCurrentStackSize();
-				int32 TransferAmount = FMath::Min(RoomInI, AmountInJ);
+				const int32 TransferAmount = FMath::Min(Slots[FrontIndex].GetAvailableSpace(),
+				                                        Slots[BackIndex].GetCurrentStackSize());
 
-				Slots[i].AddToStack(TransferAmount);
-				Slots[j].RemoveFromStack(TransferAmount);
+				UnindexSlot(FrontIndex);
+				UnindexSlot(BackIndex);
+				Slots[FrontIndex].AddToStack(TransferAmount);
+				Slots[BackIndex].RemoveFromStack(TransferAmount);
+				IndexSlot(FrontIndex);
+				IndexSlot(BackIndex);
 
-				if (Slots[i].IsFull())
+				if (Slots[FrontIndex].IsFull())
 				{
-					break;
+					++Front;
+				}
+
+				if (Slots[BackIndex].IsEmpty())
+				{
+					--Back;
 				}
 			}
 		}
 	}
 };
+
+template <>
+struct TStructOpsTypeTraits<FInventorySlots> : public TStructOpsTypeTraitsBase2<FInventorySlots>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
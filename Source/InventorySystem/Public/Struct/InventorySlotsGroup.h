@@ -2,7 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "InventorySlots.h"
+#include "InventorySlotHandle.h"
+#include "InventoryBatchResult.h"
+#include "InventoryAddPlan.h"
 #include "Items/ItemBase.h"
+#include "Algo/StableSort.h"
 #include "InventorySlotsGroup.generated.h"
 
 /**
@@ -22,8 +26,48 @@ private:
 	/** Cache for quick lookups - maps TypeID to array index */
 	mutable TMap<int32, int32> TypeIDToIndexCache;
 	
-	/** Flag to track if cache needs rebuilding */
-	mutable bool bCacheNeedsRebuild = true;
+	/** Bumped when groups are added or removed or a group's TypeIDMap changes */
+	uint32 StructureVersion = 1;
+
+	/** StructureVersion the TypeID cache was built against */
+	mutable uint32 CachedStructureVersion = 0;
+
+	/**
+	 * Owns the item totals on the heap, so the groups' links to them survive moves of this struct.
+	 * Copies start with an empty table that is rebuilt on first read.
+	 */
+	struct FItemTotalsHolder
+	{
+		TUniquePtr<FInventoryItemTotals> Table = MakeUnique<FInventoryItemTotals>();
+
+		FItemTotalsHolder() = default;
+		FItemTotalsHolder(const FItemTotalsHolder&) {}
+
+		FItemTotalsHolder(FItemTotalsHolder&& Other)
+			: Table(MoveTemp(Other.Table))
+		{
+			Other.Table = MakeUnique<FInventoryItemTotals>();
+		}
+
+		FItemTotalsHolder& operator=(const FItemTotalsHolder&)
+		{
+			Table->bNeedsRebuild = true;
+			return *this;
+		}
+
+		FItemTotalsHolder& operator=(FItemTotalsHolder&& Other)
+		{
+			Swap(Table, Other.Table);
+			Other.Table->bNeedsRebuild = true;
+			return *this;
+		}
+	};
+
+	/** Item key -> total quantity across all groups. Transient; groups apply their slot changes to it as they happen. */
+	FItemTotalsHolder GlobalItemTotals;
+
+	/** StructureVersion the groups were last linked to GlobalItemTotals at */
+	mutable uint32 GlobalTotalsStructureVersion = 0;
 
 public:
 	FInventorySlotsGroup() = default;
@@ -35,7 +79,27 @@ public:
 	void AddInventoryGroup(const FInventorySlots& NewSlots)
 	{
 		InventoryGroups.Add(NewSlots);
-		bCacheNeedsRebuild = true;
+		++StructureVersion;
+	}
+
+	/**
+	 * Removes the group registered under a TypeID.
+	 * @param TypeID Any TypeID handled by the group.
+	 * @return True if a group was removed.
+	 */
+	bool RemoveInventoryGroup(int32 TypeID)
+	{
+		EnsureCache();
+
+		const int32* IndexPtr = TypeIDToIndexCache.Find(TypeID);
+		if (!IndexPtr || !InventoryGroups.IsValidIndex(*IndexPtr))
+		{
+			return false;
+		}
+
+		InventoryGroups.RemoveAt(*IndexPtr);
+		++StructureVersion;
+		return true;
 	}
 
 	/**
@@ -43,17 +107,52 @@ public:
 	 */
 	void RebuildCache() const
 	{
-		TypeIDToIndexCache.Empty();
+		TypeIDToIndexCache.Reset();
 		for (int32 i = 0; i < InventoryGroups.Num(); ++i)
 		{
-			TArray<int32> Keys;
-			InventoryGroups[i].GetTypeIDMap().GetKeys(Keys);
-			for (int32 TypeID : Keys)
+			for (const TPair<int32, FString>& Pair : InventoryGroups[i].GetTypeIDMap())
 			{
-				TypeIDToIndexCache.Add(TypeID, i);
+				TypeIDToIndexCache.Add(Pair.Key, i);
 			}
 		}
-		bCacheNeedsRebuild = false;
+		CachedStructureVersion = StructureVersion;
+	}
+
+	/** Rebuilds the TypeID cache only if the group structure changed since it was built. */
+	FORCEINLINE void EnsureCache() const
+	{
+		if (CachedStructureVersion != StructureVersion)
+		{
+			RebuildCache();
+		}
+	}
+
+	/** Returns a counter that changes whenever groups are added, removed or retyped. */
+	FORCEINLINE uint32 GetStructureVersion() const
+	{
+		return StructureVersion;
+	}
+
+	/** Returns a counter that changes whenever groups are added or removed or any group is reinitialized. */
+	uint64 GetLayoutVersion() const
+	{
+		uint64 Version = StructureVersion;
+		for (const FInventorySlots& Group : InventoryGroups)
+		{
+			Version += Group.GetLayoutVersion();
+		}
+		return Version;
+	}
+
+	/** Returns a counter that changes whenever the layout or any group's slot contents change. */
+	uint64 GetContentVersion() const
+	{
+		uint64 Version = StructureVersion;
+		for (const FInventorySlots& Group : InventoryGroups)
+		{
+			Version += Group.GetContentVersion();
+		}
+		return Version;
 	}
 
 	/**
@@ -63,10 +162,7 @@ public:
 	 */
 	const FInventorySlots* GetGroupByID(int32 TypeID) const
 	{
-		if (bCacheNeedsRebuild)
-		{
-			RebuildCache();
-		}
+		EnsureCache();
 
 		const int32* IndexPtr = TypeIDToIndexCache.Find(TypeID);
 		if (IndexPtr && InventoryGroups.IsValidIndex(*IndexPtr))
@@ -84,10 +180,7 @@ public:
 	 */
 	FInventorySlots* GetGroupByID(int32 TypeID)
 	{
-		if (bCacheNeedsRebuild)
-		{
-			RebuildCache();
-		}
+		EnsureCache();
 
 		const int32* IndexPtr = TypeIDToIndexCache.Find(TypeID);
 		if (IndexPtr && InventoryGroups.IsValidIndex(*IndexPtr))
@@ -98,13 +191,28 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * Finds the array index of the group registered under a TypeID.
+	 * @param TypeID Any TypeID handled by the group.
+	 * @return Array index, or INDEX_NONE if no group handles the TypeID.
+	 */
+	int32 GetGroupIndexByID(int32 TypeID) const
+	{
+		EnsureCache();
+		const int32* IndexPtr = TypeIDToIndexCache.Find(TypeID);
+		return IndexPtr && InventoryGroups.IsValidIndex(*IndexPtr) ? *IndexPtr : INDEX_NONE;
+	}
+
 	/**
 	 * Optimized AddItem logic for replicated arrays with structured response.
 	 * @param ItemBase Item to add.
 	 * @param TargetTypeID Specific group to target.
+	 * @param OutTypeID Optional. Receives the TypeID of the group the item object was placed in.
+	 * @param OutSlotIndex Optional. Receives the slot the item object was placed in, or INDEX_NONE if it was fully merged into existing stacks.
 	 * @return FInventoryOperationResult indicating the status of the addition.
 	 */
-	FInventoryOperationResult AddItem(UItemBase* ItemBase, int32 TargetTypeID = -1)
+	FInventoryOperationResult AddItem(UItemBase* ItemBase, int32 TargetTypeID = -1, int32* OutTypeID = nullptr,
+	                                  int32* OutSlotIndex = nullptr)
 	{
 		if (!IsValid(ItemBase))
 		{
@@ -124,16 +232,25 @@ public:
 				return FInventoryOperationResult::Fail(TEXT("The item type is not compatible with the target group."));
 			}
 
-			return TargetGroup->AddItem(ItemBase);
+			if (OutTypeID)
+			{
+				*OutTypeID = TargetTypeID;
+			}
+			return TargetGroup->AddItem(ItemBase, OutSlotIndex);
 		}
 
-		for (FInventorySlots& Group : InventoryGroups)
+		for (int32 GroupIdx = 0; GroupIdx < InventoryGroups.Num(); ++GroupIdx)
 		{
+			FInventorySlots& Group = InventoryGroups[GroupIdx];
 			if (Group.IsTypeSupported(ItemBase))
 			{
-				FInventoryOperationResult Result = Group.AddItem(ItemBase);
+				FInventoryOperationResult Result = Group.AddItem(ItemBase, OutSlotIndex);
 				if (Result.bSuccess)
 				{
+					if (OutTypeID)
+					{
+						*OutTypeID = GetTypeIDForGroupIndex(GroupIdx);
+					}
 					return Result;
 				}
 			}
@@ -142,6 +259,112 @@ public:
 		return FInventoryOperationResult::Fail(TEXT("No suitable group found or all compatible groups are full."));
 	}
 
+	/**
+	 * Adds several items with one planning pass over the slot indexes, then writes the planned slots.
+	 * Every item is planned with PlanAdd against a shared overlay, so each sees the stacks and free slots taken by
+	 * the items before it, and no slot is written until the whole batch is planned.
+	 * Overflow from one group spills into the next compatible group, as with AddItem.
+	 * @param Items Items to add, in priority order. Invalid entries are reported as failures.
+	 * @param TargetTypeID Specific group to target, or -1 for any compatible group.
+	 * @param OutEntries Receives one entry per input item, in input order.
+	 * @return Number of items that were placed completely.
+	 */
+	int32 AddItems(TArrayView<UItemBase* const> Items, int32 TargetTypeID, TArray<FInventoryBatchAddEntry>& OutEntries)
+	{
+		OutEntries.Reset(Items.Num());
+
+		FInventoryAddPlanOverlay Overlay;
+		TArray<FInventoryAddPlan> Plans;
+		Plans.Reserve(Items.Num());
+		for (UItemBase* Item : Items)
+		{
+			Plans.Add(IsValid(Item) ? PlanAdd(Item, Item->GetCurrentStackSize(), TargetTypeID, Overlay) : FInventoryAddPlan());
+		}
+
+		int32 CompletedCount = 0;
+		for (int32 ItemIdx = 0; ItemIdx < Items.Num(); ++ItemIdx)
+		{
+			UItemBase* Item = Items[ItemIdx];
+			const FInventoryAddPlan& Plan = Plans[ItemIdx];
+
+			FInventoryBatchAddEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.Item = Item;
+
+			if (!IsValid(Item))
+			{
+				Entry.Result = FInventoryOperationResult::Fail(TEXT("Cannot add an invalid or null item."));
+				continue;
+			}
+
+			int32 Added = 0;
+			for (const FInventoryPlannedPlacement& Placement : Plan.Placements)
+			{
+				const int32 GroupIdx = GetGroupIndexByID(Placement.TypeID);
+				FInventorySlots& Group = InventoryGroups[GroupIdx];
+				if (Placement.bNewStack)
+				{
+					Group.SetSlotContents(Placement.SlotIndex, Item, Placement.Quantity);
+					Entry.TypeID = Placement.TypeID;
+					Entry.SlotIndex = Placement.SlotIndex;
+					Entry.Handle = MakeSlotHandle(GroupIdx, Placement.SlotIndex);
+					Added += Placement.Quantity;
+				}
+				else
+				{
+					Added += Placement.Quantity - Group.AddToSlotStack(Placement.SlotIndex, Placement.Quantity);
+				}
+			}
+
+			Entry.AddedQuantity = Added;
+			Entry.OverflowQuantity = Plan.RequestedQuantity - Added;
+
+			if (Entry.OverflowQuantity <= 0)
+			{
+				Entry.Result = FInventoryOperationResult::Ok();
+				++CompletedCount;
+				continue;
+			}
+
+			// As with AddItem, units that did not fit stay on the item
+			if (!Entry.WasPlaced())
+			{
+				Item->SetCurrentStackSize(Entry.OverflowQuantity);
+			}
+
+			if (Added > 0 || IsTypeSupportedAnywhere(Item, TargetTypeID))
+			{
+				Entry.Result = FInventoryOperationResult::Fail(TEXT("Inventory is full. Remaining items were left in the source object"));
+			}
+			else
+			{
+				Entry.Result = FInventoryOperationResult::Fail(TargetTypeID != -1
+					? TEXT("The item type is not compatible with the target group.")
+					: TEXT("No suitable group found for this item type."));
+			}
+		}
+
+		return CompletedCount;
+	}
+
+	/** True if the target group, or any group when TargetTypeID is -1, accepts the item's type. */
+	bool IsTypeSupportedAnywhere(const UItemBase* Item, int32 TargetTypeID) const
+	{
+		if (TargetTypeID != -1)
+		{
+			const int32 TargetGroupIdx = GetGroupIndexByID(TargetTypeID);
+			return InventoryGroups.IsValidIndex(TargetGroupIdx) && InventoryGroups[TargetGroupIdx].IsTypeSupported(Item);
+		}
+
+		for (const FInventorySlots& Group : InventoryGroups)
+		{
+			if (Group.IsTypeSupported(Item))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	/**
 	 * Transfers an item between groups with detailed result reporting.
 	 */
@@ -162,13 +385,46 @@ public:
 			return FInventoryOperationResult::Fail(TEXT("Source slot is empty or invalid."));
 		}
 
-		UItemBase* ItemToMove = SourceSlot->GetItem();
-		if (!DestGroup->IsTypeSupported(ItemToMove))
+		if (!DestGroup->IsTypeSupported(SourceSlot->GetItemPrototype()))
 		{
 			return FInventoryOperationResult::Fail(
 				TEXT("The item cannot be moved because the destination group does not support its type."));
 		}
 
+		const FInventorySlot* DestSlot = DestGroup->GetSlotAtIndex(ToIndex);
+		if (!DestSlot)
+		{
+			return FInventoryOperationResult::Fail(TEXT("Target slot index is out of bounds"));
+		}
+
+		// Value stacks have no object to remove and re-add; move the count directly
+		if (SourceSlot->IsValueStack())
+		{
+			const int32 Quantity = SourceSlot->GetCurrentStackSize();
+			if (SourceGroup->TransferSlotContents(FromIndex, *DestGroup, ToIndex, Quantity) != Quantity)
+			{
+				// Partial merges are kept; the remainder stays in the source slot
+				if (SourceSlot->GetCurrentStackSize() == Quantity)
+				{
+					return FInventoryOperationResult::Fail(TEXT("Transfer failed: the target slot cannot take the stack."));
+				}
+			}
+			return FInventoryOperationResult::Ok();
+		}
+
+		UItemBase* ItemToMove = SourceSlot->GetItem();
+
+		// Check up front that the destination can take the item, so the move never has to be undone
+		const bool bDestinationFits = DestSlot->IsEmpty()
+			|| SourceGroup == DestGroup
+			|| DestGroup->FindFirstEmptySlot() != INDEX_NONE
+			|| (ItemToMove->IsStackable()
+				&& DestGroup->GetStackRoom(ItemToMove->GetItemDefinition().GetItemKey()) >= ItemToMove->GetCurrentStackSize());
+		if (!bDestinationFits)
+		{
+			return FInventoryOperationResult::Fail(TEXT("Transfer failed: the destination group has no room for the item."));
+		}
+
 		UItemBase* RemovedItem = SourceGroup->RemoveItem(FromIndex);
 		if (!RemovedItem)
 		{
@@ -201,7 +457,7 @@ public:
 			{
 				if (!Slot.IsEmpty())
 				{
-					FString ItemDisplayName = Slot.GetItem()->GetItemDefinition().GetItemName().ToString();
+					FString ItemDisplayName = Slot.GetItemPrototype()->GetItemDefinition().GetItemName().ToString();
 					if (ItemDisplayName.Contains(SearchName))
 					{
 						FoundSlots.Add(&Slot);
@@ -226,19 +482,364 @@ public:
 	/**
 	 * Calculates the total quantity of a specific item across all managed groups.
 	 * Useful for crafting or quest requirements.
-	 * @param ItemID The unique FName identifier of the item.
+	 * @param ItemID The unique identifier of the item.
 	 * @return Total count of the item in the entire inventory system.
 	 */
 	int32 GetGlobalTotalItemCount(const FString& ItemID) const
 	{
-		int32 GrandTotal = 0;
+		return GetGlobalTotalItemCount(FItemDefinition::MakeItemKey(ItemID));
+	}
+
+	/**
+	 * Calculates the total quantity of a specific item across all managed groups.
+	 * Served from a table the groups keep current as their slots change.
+	 * @param ItemKey The interned item identity (FItemDefinition::GetItemKey).
+	 * @return Total count of the item in the entire inventory system.
+	 */
+	int32 GetGlobalTotalItemCount(uint64 ItemKey) const
+	{
+		EnsureGlobalTotals();
+		const int32* Total = GlobalItemTotals.Table->Totals.Find(ItemKey);
+		return Total ? *Total : 0;
+	}
+
+	/**
+	 * Simulates AddItem without touching any slot.
+	 * Mirrors AddItem group by group: tops up partial stacks of the item in slot order, then places the item object
+	 * in the first free slot, where at most one stack fits.
+	 * @param Item The item to plan for. Only its definition and stack rules are read.
+	 * @param Quantity Units to place.
+	 * @param TargetTypeID Specific group to target, or -1 for any compatible group.
+	 * @param Overlay Units planned by earlier calls in the same batch. Updated with this plan.
+	 * @return How much fits and where.
+	 */
+	FInventoryAddPlan PlanAdd(const UItemBase* Item, int32 Quantity, int32 TargetTypeID, FInventoryAddPlanOverlay& Overlay) const
+	{
+		FInventoryAddPlan Plan;
+		Plan.RequestedQuantity = Quantity;
+
+		if (!IsValid(Item) || Quantity <= 0)
+		{
+			return Plan;
+		}
+
+		const uint64 ItemKey = Item->GetItemDefinition().GetItemKey();
+		const FInventoryTypeMask& ItemTypeMask = Item->GetItemDefinition().GetSlotTypeMask();
+		const int32 MaxStack = FMath::Max(Item->GetMaxStackSize(), 1);
+
+		const int32 TargetGroupIdx = TargetTypeID != -1 ? GetGroupIndexByID(TargetTypeID) : INDEX_NONE;
+		if (TargetTypeID != -1 && TargetGroupIdx == INDEX_NONE)
+		{
+			return Plan;
+		}
+
+		const int32 FirstGroup = TargetTypeID != -1 ? TargetGroupIdx : 0;
+		const int32 LastGroup = TargetTypeID != -1 ? TargetGroupIdx : InventoryGroups.Num() - 1;
+
+		for (int32 GroupIdx = FirstGroup; GroupIdx <= LastGroup; ++GroupIdx)
+		{
+			const FInventorySlots& Group = InventoryGroups[GroupIdx];
+			if (!Group.GetTypeMask().Intersects(ItemTypeMask))
+			{
+				continue;
+			}
+
+			const int32 TypeID = GetTypeIDForGroupIndex(GroupIdx);
+
+			if (Item->IsStackable())
+			{
+				TArray<int32> StackSlots = Group.GetPartialStackSlots(ItemKey);
+				for (const TPair<TPair<int32, int32>, FInventoryAddPlanOverlay::FPlannedSlot>& Planned : Overlay.Slots)
+				{
+					if (Planned.Key.Key == GroupIdx && Planned.Value.bClaimed && Planned.Value.ItemKey == ItemKey)
+					{
+						StackSlots.Add(Planned.Key.Value);
+					}
+				}
+				StackSlots.Sort();
+
+				for (int32 SlotIndex : StackSlots)
+				{
+					const FInventorySlot& Slot = *Group.GetSlotAtIndex(SlotIndex);
+					FInventoryAddPlanOverlay::FPlannedSlot& Planned = Overlay.FindOrAdd(GroupIdx, SlotIndex);
+					const int32 SlotMax = Planned.bClaimed ? Planned.MaxStack : Slot.GetMaxStackSize();
+					const int32 SlotSize = Planned.bClaimed ? 0 : Slot.GetCurrentStackSize();
+					const int32 Taken = FMath::Min(Quantity - Plan.FitQuantity, SlotMax - SlotSize - Planned.AddedQuantity);
+					if (Taken <= 0)
+					{
+						continue;
+					}
+
+					Planned.ItemKey = ItemKey;
+					Planned.AddedQuantity += Taken;
+					Plan.FitQuantity += Taken;
+					Plan.Placements.Emplace(TypeID, SlotIndex, Taken, false);
+
+					if (Plan.FitQuantity == Quantity)
+					{
+						return Plan;
+					}
+				}
+			}
+
+			int32 FreeIndex = Group.FindFirstEmptySlot();
+			while (FreeIndex != INDEX_NONE)
+			{
+				const FInventoryAddPlanOverlay::FPlannedSlot* Planned = Overlay.Find(GroupIdx, FreeIndex);
+				if (!Planned || !Planned->bClaimed)
+				{
+					break;
+				}
+				FreeIndex = Group.FindNextEmptySlot(FreeIndex + 1);
+			}
+
+			if (FreeIndex != INDEX_NONE)
+			{
+				const int32 Taken = FMath::Min(Quantity - Plan.FitQuantity, MaxStack);
+				FInventoryAddPlanOverlay::FPlannedSlot& Claimed = Overlay.FindOrAdd(GroupIdx, FreeIndex);
+				Claimed.ItemKey = ItemKey;
+				Claimed.AddedQuantity = Taken;
+				Claimed.MaxStack = MaxStack;
+				Claimed.bClaimed = true;
+
+				Plan.FitQuantity += Taken;
+				Plan.Placements.Emplace(TypeID, FreeIndex, Taken, true);
+
+				// The item object is placed; AddItem stops here
+				return Plan;
+			}
+		}
+
+		return Plan;
+	}
+
+	/**
+	 * Adds units of a module-less stackable as value stacks: partial stacks are topped up first, then empty slots are filled.
+	 * No item objects are created. All-or-nothing: if the units do not all fit, nothing is added.
+	 * @param ItemClass Class that supports value stacks (UItemBase::SupportsValueStacks).
+	 * @param Quantity Units to add.
+	 * @param TargetTypeID Specific group to target, or -1 for any compatible group.
+	 * @param OutChangedSlots Receives a handle for every slot that was written.
+	 * @return False if there was not enough room.
+	 */
+	bool AddValueStacks(TSubclassOf<UItemBase> ItemClass, int32 Quantity, int32 TargetTypeID,
+	                    TArray<FInventorySlotHandle>& OutChangedSlots)
+	{
+		if (!ItemClass || Quantity <= 0)
+		{
+			return false;
+		}
+
+		const UItemBase* Prototype = ItemClass->GetDefaultObject<UItemBase>();
+		const uint64 ItemKey = Prototype->GetItemDefinition().GetItemKey();
+		const int32 MaxStack = FMath::Max(Prototype->GetMaxStackSize(), 1);
+
+		const int32 TargetGroupIdx = TargetTypeID != -1 ? GetGroupIndexByID(TargetTypeID) : INDEX_NONE;
+		if (TargetTypeID != -1 && TargetGroupIdx == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const int32 FirstGroup = TargetTypeID != -1 ? TargetGroupIdx : 0;
+		const int32 LastGroup = TargetTypeID != -1 ? TargetGroupIdx : InventoryGroups.Num() - 1;
+
+		int64 Room = 0;
+		for (int32 GroupIdx = FirstGroup; GroupIdx <= LastGroup && Room < Quantity; ++GroupIdx)
+		{
+			const FInventorySlots& Group = InventoryGroups[GroupIdx];
+			if (Group.IsTypeSupported(Prototype))
+			{
+				Room += Group.GetStackRoom(ItemKey)
+					+ static_cast<int64>(Group.GetSlots().Num() - Group.GetOccupiedSlotCount()) * MaxStack;
+			}
+		}
+		if (Room < Quantity)
+		{
+			return false;
+		}
+
+		int32 Remaining = Quantity;
+		for (int32 GroupIdx = FirstGroup; GroupIdx <= LastGroup && Remaining > 0; ++GroupIdx)
+		{
+			FInventorySlots& Group = InventoryGroups[GroupIdx];
+			if (!Group.IsTypeSupported(Prototype))
+			{
+				continue;
+			}
+
+			for (int32 SlotIndex : Group.GetPartialStackSlots(ItemKey))
+			{
+				Remaining = Group.AddToSlotStack(SlotIndex, Remaining);
+				OutChangedSlots.Add(MakeSlotHandle(GroupIdx, SlotIndex));
+				if (Remaining <= 0)
+				{
+					break;
+				}
+			}
+
+			int32 FreeIndex = Remaining > 0 ? Group.FindFirstEmptySlot() : INDEX_NONE;
+			while (FreeIndex != INDEX_NONE && Remaining > 0)
+			{
+				Group.SetValueStackContents(FreeIndex, ItemClass, Remaining);
+				Remaining -= Group.GetSlotAtIndex(FreeIndex)->GetCurrentStackSize();
+				OutChangedSlots.Add(MakeSlotHandle(GroupIdx, FreeIndex));
+				FreeIndex = Group.FindNextEmptySlot(FreeIndex + 1);
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Removes exact quantities of one or more items, draining the smallest stacks first across all groups.
+	 * All-or-nothing: if any item is short, nothing is removed.
+	 * @param Requests Item key and quantity pairs. A key may appear more than once.
+	 * @param OutEmptiedItems Receives the item objects whose slots were emptied.
+	 * @param OutChangedSlots Receives a handle for every slot that was written.
+	 * @return Ok, or Fail naming the first item that is short.
+	 */
+	FInventoryOperationResult ConsumeItems(TArrayView<const TPair<uint64, int32>> Requests,
+	                                       TArray<UItemBase*>& OutEmptiedItems,
+	                                       TArray<FInventorySlotHandle>& OutChangedSlots)
+	{
+		TMap<uint64, int32, TInlineSetAllocator<8>> Needed;
+		for (const TPair<uint64, int32>& Request : Requests)
+		{
+			if (Request.Value <= 0)
+			{
+				return FInventoryOperationResult::Fail(FString::Printf(TEXT("Invalid quantity %d"), Request.Value));
+			}
+			Needed.FindOrAdd(Request.Key) += Request.Value;
+		}
+
+		for (const TPair<uint64, int32>& Pair : Needed)
+		{
+			const int32 Held = GetGlobalTotalItemCount(Pair.Key);
+			if (Held < Pair.Value)
+			{
+				return FInventoryOperationResult::Fail(FString::Printf(
+					TEXT("Not enough items: %d held, %d required"), Held, Pair.Value));
+			}
+		}
+
+		struct FStackRef
+		{
+			int32 StackSize;
+			int32 GroupIdx;
+			int32 SlotIndex;
+		};
+
+		TArray<FStackRef, TInlineAllocator<16>> Stacks;
+		for (const TPair<uint64, int32>& Pair : Needed)
+		{
+			Stacks.Reset();
+			for (int32 GroupIdx = 0; GroupIdx < InventoryGroups.Num(); ++GroupIdx)
+			{
+				InventoryGroups[GroupIdx].ForEachItemStack(Pair.Key, [&Stacks, GroupIdx](int32 SlotIndex, int32 StackSize)
+				{
+					Stacks.Add({StackSize, GroupIdx, SlotIndex});
+				});
+			}
+
+			Algo::StableSortBy(Stacks, &FStackRef::StackSize);
+
+			int32 Remaining = Pair.Value;
+			for (const FStackRef& Stack : Stacks)
+			{
+				if (Remaining <= 0)
+				{
+					break;
+				}
+
+				FInventorySlots& Group = InventoryGroups[Stack.GroupIdx];
+				UItemBase* StackItem = Group.GetSlotAtIndex(Stack.SlotIndex)->GetItem();
+				const int32 Taken = FMath::Min(Remaining, Stack.StackSize);
+
+				Group.RemoveStackAmountFromSlot(Stack.SlotIndex, Taken);
+				Remaining -= Taken;
+
+				// Value stacks have no object to release
+				if (StackItem && Group.GetSlotAtIndex(Stack.SlotIndex)->IsEmpty())
+				{
+					OutEmptiedItems.Add(StackItem);
+				}
+				OutChangedSlots.Add(MakeSlotHandle(Stack.GroupIdx, Stack.SlotIndex));
+			}
+		}
+
+		return FInventoryOperationResult::Ok();
+	}
+
+	/**
+	 * Visits the total quantity of every item across all groups.
+	 * @param Visitor Called once per item key with its total quantity.
+	 */
+	void ForEachGlobalItemTotal(TFunctionRef<void(uint64, int32)> Visitor) const
+	{
+		EnsureGlobalTotals();
+
+		for (const TPair<uint64, int32>& Pair : GlobalItemTotals.Table->Totals)
+		{
+			Visitor(Pair.Key, Pair.Value);
+		}
+	}
+
+	/**
+	 * Collects handles to every slot written since the consumer's previous call and clears its changed set in each group.
+	 * @param OutHandles Receives the handles, group by group in slot order.
+	 */
+	void ConsumeChangedSlots(EInventorySlotChangeConsumer Consumer, TArray<FInventorySlotHandle>& OutHandles)
+	{
+		for (int32 GroupIdx = 0; GroupIdx < InventoryGroups.Num(); ++GroupIdx)
+		{
+			InventoryGroups[GroupIdx].ConsumeChangedSlots(Consumer, [this, GroupIdx, &OutHandles](int32 SlotIndex)
+			{
+				OutHandles.Add(MakeSlotHandle(GroupIdx, SlotIndex));
+			});
+		}
+	}
 
+	/**
+	 * Recounts every slot and compares the result against the cached item totals.
+	 * @param OutErrors Receives a description of each mismatch.
+	 * @return True if the cached totals match a full recount.
+	 */
+	bool ValidateItemTotals(TArray<FString>& OutErrors) const
+	{
+		TMap<uint64, int32> Recount;
 		for (const FInventorySlots& Group : InventoryGroups)
 		{
-			GrandTotal += Group.GetTotalItemCount(ItemID);
+			for (const FInventorySlot& Slot : Group.GetSlots())
+			{
+				if (!Slot.IsEmpty() && IsValid(Slot.GetItemPrototype()))
+				{
+					Recount.FindOrAdd(Slot.GetItemPrototype()->GetItemDefinition().GetItemKey()) += Slot.GetCurrentStackSize();
+				}
+			}
+		}
+
+		EnsureGlobalTotals();
+		const TMap<uint64, int32>& CachedTotals = GlobalItemTotals.Table->Totals;
+
+		bool bIsValid = Recount.Num() == CachedTotals.Num();
+		for (const TPair<uint64, int32>& Pair : Recount)
+		{
+			const int32* Cached = CachedTotals.Find(Pair.Key);
+			if (!Cached || *Cached != Pair.Value)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Item total mismatch for key %llu: cached %d, recount %d"),
+					Pair.Key, Cached ? *Cached : 0, Pair.Value));
+				bIsValid = false;
+			}
+		}
+
+		if (Recount.Num() != CachedTotals.Num())
+		{
+			OutErrors.Add(FString::Printf(TEXT("Item totals track %d items, recount found %d"),
+				CachedTotals.Num(), Recount.Num()));
 		}
 
-		return GrandTotal;
+		return bIsValid;
 	}
 
 	/**
@@ -257,9 +858,12 @@ public:
 		return InventoryGroups;
 	}
 
-	FORCEINLINE TArray<FInventorySlots>& GetInventoryGroups()
+	/**
+	 * Mutable view for slot-level edits. Groups cannot be added or removed through it, so the TypeID cache stays valid.
+	 * Call InvalidateCache() after re-initializing a group with a different TypeIDMap.
+	 */
+	FORCEINLINE TArrayView<FInventorySlots> GetInventoryGroupsMutable()
 	{
-		bCacheNeedsRebuild = true;
 		return InventoryGroups;
 	}
 
@@ -273,10 +877,19 @@ public:
 		return InventoryGroups.IsValidIndex(Index) ? &InventoryGroups[Index] : nullptr;
 	}
 
-	/** Call this after directly modifying InventoryGroups to force a cache rebuild on next lookup. */
+	/** Call this after the group layout changed outside of this struct (e.g. replication) to force a cache rebuild on next lookup. */
 	void InvalidateCache()
 	{
-		bCacheNeedsRebuild = true;
+		++StructureVersion;
+	}
+
+	/** Marks every group's item index for rebuild. Used when slot data arrives through replication. */
+	void MarkSlotIndexesDirty()
+	{
+		for (FInventorySlots& Group : InventoryGroups)
+		{
+			Group.MarkSlotIndexDirty();
+		}
 	}
 
 	/**
@@ -295,6 +908,82 @@ public:
 		return It ? It.Key() : -1;
 	}
 
+	/**
+	 * Builds a handle for a slot.
+	 * @param GroupIdx Array index of the group.
+	 * @param SlotIndex Slot index within the group.
+	 * @return Handle carrying the slot's current generation, or an unset handle for invalid indices.
+	 */
+	FInventorySlotHandle MakeSlotHandle(int32 GroupIdx, int32 SlotIndex) const
+	{
+		if (!InventoryGroups.IsValidIndex(GroupIdx))
+		{
+			return FInventorySlotHandle();
+		}
+
+		const int32 Generation = InventoryGroups[GroupIdx].GetSlotGeneration(SlotIndex);
+		return Generation != INDEX_NONE ? FInventorySlotHandle(GroupIdx, SlotIndex, Generation) : FInventorySlotHandle();
+	}
+
+	/**
+	 * Builds a handle for a slot addressed by TypeID.
+	 * @param TypeID Any TypeID handled by the group.
+	 * @param SlotIndex Slot index within the group.
+	 * @return Handle carrying the slot's current generation, or an unset handle if not found.
+	 */
+	FInventorySlotHandle MakeSlotHandleByTypeID(int32 TypeID, int32 SlotIndex) const
+	{
+		EnsureCache();
+		const int32* IndexPtr = TypeIDToIndexCache.Find(TypeID);
+		return IndexPtr ? MakeSlotHandle(*IndexPtr, SlotIndex) : FInventorySlotHandle();
+	}
+
+	/**
+	 * Checks that a handle still refers to the same item object it was made for.
+	 * @param Handle The handle to check.
+	 * @return True if the slot exists and its generation is unchanged.
+	 */
+	bool IsHandleValid(const FInventorySlotHandle& Handle) const
+	{
+		return Handle.IsSet()
+			&& InventoryGroups.IsValidIndex(Handle.GroupIndex)
+			&& InventoryGroups[Handle.GroupIndex].GetSlotGeneration(Handle.SlotIndex) == Handle.Generation;
+	}
+
+	/**
+	 * Resolves a handle to its slot.
+	 * @param Handle The handle to resolve.
+	 * @return The slot, or nullptr if the handle is stale or unset.
+	 */
+	const FInventorySlot* ResolveHandle(const FInventorySlotHandle& Handle) const
+	{
+		return IsHandleValid(Handle) ? InventoryGroups[Handle.GroupIndex].GetSlotAtIndex(Handle.SlotIndex) : nullptr;
+	}
+
+	/**
+	 * Finds the handle of the slot holding a given item object.
+	 * @param Item The item to look up.
+	 * @return Handle to the item's slot, or an unset handle if not found.
+	 */
+	FInventorySlotHandle FindItemHandle(const UItemBase* Item) const
+	{
+		if (!IsValid(Item))
+		{
+			return FInventorySlotHandle();
+		}
+
+		for (int32 GroupIdx = 0; GroupIdx < InventoryGroups.Num(); ++GroupIdx)
+		{
+			const int32 SIdx = InventoryGroups[GroupIdx].FindSlotByItem(Item);
+			if (SIdx != INDEX_NONE)
+			{
+				return MakeSlotHandle(GroupIdx, SIdx);
+			}
+		}
+
+		return FInventorySlotHandle();
+	}
+
 	/**
 	 * Finds the TypeID and slot index for a given item across all groups.
 	 * Returns true if found, populating OutTypeID and OutSlotIndex.
@@ -308,17 +997,37 @@ public:
 
 		for (int32 GroupIdx = 0; GroupIdx < InventoryGroups.Num(); ++GroupIdx)
 		{
-			const TArray<FInventorySlot>& Slots = InventoryGroups[GroupIdx].GetSlots();
-			for (int32 SIdx = 0; SIdx < Slots.Num(); ++SIdx)
+			const int32 SIdx = InventoryGroups[GroupIdx].FindSlotByItem(Item);
+			if (SIdx != INDEX_NONE)
 			{
-				if (Slots[SIdx].GetItem() == Item)
-				{
-					OutTypeID = GetTypeIDForGroupIndex(GroupIdx);
-					OutSlotIndex = SIdx;
-					return true;
-				}
+				OutTypeID = GetTypeIDForGroupIndex(GroupIdx);
+				OutSlotIndex = SIdx;
+				return true;
 			}
 		}
 		return false;
 	}
+
+private:
+	/**
+	 * Recounts GlobalItemTotals and links every group to it if groups were added, removed or replaced since the last link.
+	 * Otherwise the table is already current and this is a single comparison.
+	 */
+	void EnsureGlobalTotals() const
+	{
+		FInventoryItemTotals& Totals = *GlobalItemTotals.Table;
+		if (!Totals.bNeedsRebuild && GlobalTotalsStructureVersion == StructureVersion)
+		{
+			return;
+		}
+
+		Totals.Totals.Reset();
+		for (const FInventorySlots& Group : InventoryGroups)
+		{
+			Group.LinkItemTotals(&Totals);
+		}
+
+		Totals.bNeedsRebuild = false;
+		GlobalTotalsStructureVersion = StructureVersion;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+/**
+ * Precomputed set of inventory slot type IDs.
+ * IDs below MaskBits live in a single word so overlap tests are one AND;
+ * larger IDs fall back to a small sorted array.
+ */
+struct FInventoryTypeMask
+{
+	static constexpr int32 MaskBits = 64;
+
+	uint64 Bits = 0;
+
+	/** Type IDs >= MaskBits, kept sorted */
+	TArray<int32> OverflowIDs;
+
+	FInventoryTypeMask() = default;
+
+	explicit FInventoryTypeMask(const TArray<int32>& TypeIDs)
+	{
+		for (int32 TypeID : TypeIDs)
+		{
+			Add(TypeID);
+		}
+	}
+
+	void Add(int32 TypeID)
+	{
+		if (TypeID < 0)
+		{
+			return;
+		}
+
+		if (TypeID < MaskBits)
+		{
+			Bits |= 1ull << TypeID;
+			return;
+		}
+
+		const int32 Position = Algo::LowerBound(OverflowIDs, TypeID);
+		if (!OverflowIDs.IsValidIndex(Position) || OverflowIDs[Position] != TypeID)
+		{
+			OverflowIDs.Insert(TypeID, Position);
+		}
+	}
+
+	void Reset()
+	{
+		Bits = 0;
+		OverflowIDs.Reset();
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Bits == 0 && OverflowIDs.Num() == 0;
+	}
+
+	FORCEINLINE bool Contains(int32 TypeID) const
+	{
+		if (TypeID < 0)
+		{
+			return false;
+		}
+
+		if (TypeID < MaskBits)
+		{
+			return (Bits & (1ull << TypeID)) != 0;
+		}
+
+		return Algo::BinarySearch(OverflowIDs, TypeID) != INDEX_NONE;
+	}
+
+	/**
+	 * Checks whether the two sets share at least one type ID.
+	 * @param Other The set to test against.
+	 * @return True if any type ID is present in both.
+	 */
+	FORCEINLINE bool Intersects(const FInventoryTypeMask& Other) const
+	{
+		if ((Bits & Other.Bits) != 0)
+		{
+			return true;
+		}
+
+		if (OverflowIDs.Num() == 0 || Other.OverflowIDs.Num() == 0)
+		{
+			return false;
+		}
+
+		int32 A = 0;
+		int32 B = 0;
+		while (A < OverflowIDs.Num() && B < Other.OverflowIDs.Num())
+		{
+			if (OverflowIDs[A] == Other.OverflowIDs[B])
+			{
+				return true;
+			}
+
+			if (OverflowIDs[A] < Other.OverflowIDs[B])
+			{
+				++A;
+			}
+			else
+			{
+				++B;
+			}
+		}
+
+		return false;
+	}
+};
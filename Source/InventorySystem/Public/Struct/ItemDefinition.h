@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "InventorySystem.h"
 #include "Engine/Texture2D.h"
+#include "Hash/CityHash.h"
+#include "InventoryTypeMask.h"
 #include "ItemDefinition.generated.h"
 
 /**
@@ -30,6 +32,12 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Item Data")
 	TArray<int32> InventorySlotTypeIDs;
 
+	/** Case-sensitive hash of ItemID. Not serialized; refreshed whenever ItemID is written. */
+	uint64 ItemKey = 0;
+
+	/** InventorySlotTypeIDs as a mask. Not serialized; refreshed whenever the type IDs change. */
+	FInventoryTypeMask SlotTypeMask;
+
 public:
 	FItemDefinition()
 		: ItemID(TEXT("None"))
@@ -38,13 +46,28 @@ public:
 		  , ItemIcon(nullptr) 
 	{ 
 		InventorySlotTypeIDs.Add(0); 
+		RefreshCachedData();
+	}
+
+	/**
+	 * Hashes an item ID into the key used for identity comparisons.
+	 * @param InItemID The item ID string.
+	 * @return 64-bit case-sensitive hash of the ID.
+	 */
+	static uint64 MakeItemKey(const FString& InItemID)
+	{
+		return CityHash64(reinterpret_cast<const char*>(*InItemID), InItemID.Len() * sizeof(TCHAR));
 	}
 
 	FORCEINLINE const FString& GetItemID() const { return ItemID; }
+
+	/** Interned identity of ItemID. Use this for equality checks; the string is for display and save data. */
+	FORCEINLINE uint64 GetItemKey() const { return ItemKey; }
 	FORCEINLINE const FText& GetItemName() const { return ItemName; }
 	FORCEINLINE const FText& GetItemDescription() const { return ItemDescription; }
 	FORCEINLINE TSoftObjectPtr<UTexture2D> GetItemIcon() const { return ItemIcon; }
 	FORCEINLINE const TArray<int32>& GetInventorySlotTypeIDs() const { return InventorySlotTypeIDs; }
+	FORCEINLINE const FInventoryTypeMask& GetSlotTypeMask() const { return SlotTypeMask; }
 
 
 	/** Rejects empty strings and logs a warning. */
@@ -53,6 +76,7 @@ public:
 		if (!NewID.IsEmpty())
 		{
 			ItemID = NewID; 
+			ItemKey = MakeItemKey(ItemID);
 		}
 		else
 		{
@@ -102,6 +126,7 @@ public:
 		if (bAllValid)
 		{
 			InventorySlotTypeIDs = NewTypeIDs;
+			SlotTypeMask = FInventoryTypeMask(InventorySlotTypeIDs);
 		}
 		else
 		{
@@ -123,6 +148,7 @@ public:
 
 			const int32 NumBefore = InventorySlotTypeIDs.Num();
 		InventorySlotTypeIDs.AddUnique(NewTypeID);
+		SlotTypeMask.Add(NewTypeID);
 		
 		if (InventorySlotTypeIDs.Num() == NumBefore)
 		{
@@ -141,6 +167,7 @@ public:
 		
 		if (Removed > 0)
 		{
+			SlotTypeMask = FInventoryTypeMask(InventorySlotTypeIDs);
 			UE_LOG(LogInventory, Verbose, TEXT("ItemDefinition: Removed TypeID %d"), TypeID);
 			return true;
 		}
@@ -156,12 +183,13 @@ public:
 	 */
 	FORCEINLINE bool HasInventorySlotTypeID(int32 TypeID) const
 	{
-		return InventorySlotTypeIDs.Contains(TypeID);
+		return SlotTypeMask.Contains(TypeID);
 	}
 
 	void ClearInventorySlotTypeIDs()
 	{
 		InventorySlotTypeIDs.Empty();
+		SlotTypeMask.Reset();
 		UE_LOG(LogInventory, Verbose, TEXT("ItemDefinition: Cleared all TypeIDs"));
 	}
 	
@@ -204,6 +232,21 @@ public:
 		return bIsValid;
 	}
 
+	/** Recomputes ItemKey and SlotTypeMask. Call after properties were written through reflection (editor, replication). */
+	void RefreshCachedData()
+	{
+		ItemKey = MakeItemKey(ItemID);
+		SlotTypeMask = FInventoryTypeMask(InventorySlotTypeIDs);
+	}
+
+	void PostSerialize(const FArchive& Ar)
+	{
+		if (Ar.IsLoading())
+		{
+			RefreshCachedData();
+		}
+	}
+
 	FString ToString() const
 	{
 		return FString::Printf(TEXT("ItemDefinition[ID=%s, Name=%s, Types=%d]"),
@@ -214,11 +257,20 @@ public:
 
 	bool operator==(const FItemDefinition& Other) const
 	{
-		return ItemID == Other.ItemID;
+		return ItemKey == Other.ItemKey;
 	}
 
 	bool operator!=(const FItemDefinition& Other) const
 	{
-		return ItemID != Other.ItemID;
+		return ItemKey != Other.ItemKey;
 	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FItemDefinition> : public TStructOpsTypeTraitsBase2<FItemDefinition>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
\ No newline at end of file